@@ -5,6 +5,11 @@
 #include <string>
 #include <boost/tuple/tuple.hpp>
 #include <numeric>
+#include <fstream>
+#include <cstring>
+#include <climits>
+#include <deque>
+#include <thread>
 #include "gnuplot-iostream.h"
 
 #include "stb_image.h"
@@ -13,6 +18,26 @@
 #include "simpleResize.h"
 #include "serial_ResizeBicubic.h"
 #include "openMP_ResizeBicubic.h"
+#include "separable_ResizeBicubic.h"
+#include "simd_ResizeBicubic.h"
+#include "fixedPoint_ResizeBicubic.h"
+#include "pyramid_ResizeBicubic.h"
+#include "pool_ResizeBicubic.h"
+#include "threadPool.h"
+#include "batch_ResizeBicubic.h"
+#include "stream_ResizeBicubic.h"
+#include "resizeEngine.h"
+#include "mpmcQueue.h"
+#include "bufferArena.h"
+#include "asyncFileIO.h"
+#include "auto_ResizeBicubic.h"
+#include "threadAffinity.h"
+#include "numa_ResizeBicubic.h"
+#include "imageView.h"
+#include "resizeCore.h"
+#include "tiledImage.h"
+#include "outOfCore_ResizeBicubic.h"
+#include "mappedImage.h"
 #include "cuda_ResizeBicubic.cuh"
 
 using namespace std;
@@ -26,15 +51,27 @@ unsigned char* loadImage(const char* filename, int& width, int& height, int& cha
     return img;
 }
 
-// Function to save the image
-bool saveImage(const char* filename, unsigned char* imgData, int width, int height, int channels) {
-    if (!stbi_write_png(filename, width, height, channels, imgData, width * channels)) {
+// Saves a view as is; stbi_write_png takes the row stride, so regions need no copy
+bool saveImage(const char* filename, const ImageView& image) {
+    // stb_image_write sizes its filtered copy as (width * channels + 1) * height
+    // in an int, so gigapixel outputs would overflow it rather than fail cleanly
+    if (((size_t)image.width * image.channels + 1) * image.height > (size_t)INT_MAX) {
+        cerr << "Failed to save image: " << filename << " (" << image.width << "x" << image.height
+            << " is too large for PNG)" << endl;
+        return false;
+    }
+    if (!stbi_write_png(filename, image.width, image.height, image.channels, image.data, (int)image.pitch)) {
         cerr << "Failed to save image: " << filename << endl;
         return false;
     }
     return true;
 }
 
+// Function to save the image
+bool saveImage(const char* filename, unsigned char* imgData, int width, int height, int channels) {
+    return saveImage(filename, ImageView(imgData, width, height, channels));
+}
+
 // Function to resize image using a specific method
 double resizeImage(void (*resizeFunc)(unsigned char*, int, int, int, unsigned char*, int, int),
     const char* inputFileName, const char* outputFileName, int newWidth, int newHeight) {
@@ -44,34 +81,56 @@ double resizeImage(void (*resizeFunc)(unsigned char*, int, int, int, unsigned ch
         return -1;
     }
 
-    unsigned char* resizedImg = new unsigned char[newWidth * newHeight * channels];
+    // borrowed from the arena, so repeated trials reuse already-faulted pages
+    ArenaBuffer<unsigned char> resizedImg((size_t)newWidth * newHeight * channels);
     double start_time = omp_get_wtime();
-    resizeFunc(img, width, height, channels, resizedImg, newWidth, newHeight);
+    resizeFunc(img, width, height, channels, resizedImg.data(), newWidth, newHeight);
     double run_time = omp_get_wtime() - start_time;
 
-    if (!saveImage(outputFileName, resizedImg, newWidth, newHeight, channels)) {
+    if (!saveImage(outputFileName, resizedImg.data(), newWidth, newHeight, channels)) {
         stbi_image_free(img);
-        delete[] resizedImg;
         return -1;
     }
 
     stbi_image_free(img);
-    delete[] resizedImg;
+    return run_time;
+}
+
+// Function to resize between memory-mapped PPM/PGM/PAM/raw files: the source is read in place and the
+// output lands straight in the mapped destination, so there is no decode, encode or extra copy
+double mapped_resizeImage(ViewResizeFunc resizeFunc, const char* inputFileName, const char* outputFileName, int newWidth, int newHeight) {
+    MappedImage src;
+    if (!src.open(inputFileName)) {
+        return -1;
+    }
+    MappedImage dst;
+    if (!dst.create(outputFileName, newWidth, newHeight, src.channels())) {
+        return -1;
+    }
+
+    double start_time = omp_get_wtime();
+    resizeFunc(src.view(), dst.view());
+    double run_time = omp_get_wtime() - start_time;
+
+    if (!dst.flush()) {
+        cerr << "Failed to save image: " << outputFileName << endl;
+        return -1;
+    }
     return run_time;
 }
 
 // Function to calculate Mean Squared Error (MSE) between two images
 double calculateMSE(const unsigned char* img1, const unsigned char* img2, int width, int height, int channels) {
     double mse = 0.0;
-    int totalPixels = width * height * channels;
+    ptrdiff_t totalSamples = (ptrdiff_t)width * height * channels;
 
-    #pragma omp parallel for
-    for (int i = 0; i < totalPixels; ++i) {
+    #pragma omp parallel for reduction(+:mse)
+    for (ptrdiff_t i = 0; i < totalSamples; ++i) {
         double diff = (double)img1[i] - (double)img2[i];
         mse += diff * diff;
     }
 
-    return mse / totalPixels;
+    return mse / totalSamples;
 }
 
 // Function to generate output file names based on input file and method
@@ -94,6 +153,16 @@ void experiment_processImage(const char* inputFileName, int w[]) {
     vector<double> openmp_pg_result = { 0, 0, 0, 0, 0 };
     vector<double> cuda_exec_time = { 0, 0, 0, 0, 0 };
     vector<double> cuda_pg_result = { 0, 0, 0, 0, 0 };
+    vector<double> separable_exec_time = { 0, 0, 0, 0, 0 };
+    vector<double> separable_pg_result = { 0, 0, 0, 0, 0 };
+    vector<double> simd_exec_time = { 0, 0, 0, 0, 0 };
+    vector<double> simd_pg_result = { 0, 0, 0, 0, 0 };
+    vector<double> fixed_exec_time = { 0, 0, 0, 0, 0 };
+    vector<double> fixed_pg_result = { 0, 0, 0, 0, 0 };
+    vector<double> lanczos2_exec_time = { 0, 0, 0, 0, 0 };
+    vector<double> lanczos3_exec_time = { 0, 0, 0, 0, 0 };
+    vector<double> antialias_exec_time = { 0, 0, 0, 0, 0 };
+    vector<double> pyramid_exec_time = { 0, 0, 0, 0, 0 };
 
     const int numTrials = 5;
 
@@ -118,9 +187,20 @@ void experiment_processImage(const char* inputFileName, int w[]) {
 
         vector<double> timesSerial(numTrials);
         vector<double> timesOpenMP(numTrials);
+        vector<double> timesOpenMPFlat(numTrials);
         vector<double> timesCUDA(numTrials);
+        vector<double> timesSeparable(numTrials);
+        vector<double> timesSIMD(numTrials);
+        vector<double> timesFixed(numTrials);
+        vector<double> timesLanczos2(numTrials);
+        vector<double> timesLanczos3(numTrials);
+        vector<double> timesAntialias(numTrials);
+        vector<double> timesPyramid(numTrials);
         vector<double> mseOpenMP(numTrials);
         vector<double> mseCUDA(numTrials);
+        vector<double> mseSeparable(numTrials);
+        vector<double> mseSIMD(numTrials);
+        vector<double> mseFixed(numTrials);
 
         bool validResults = true;
 
@@ -138,12 +218,54 @@ void experiment_processImage(const char* inputFileName, int w[]) {
             double openmpTime = resizeImage(openMP_ResizeBicubic, inputFileName, outputOpenMP.c_str(), width, newHeight);
             timesOpenMP[trial] = openmpTime;
 
+            // Process using the untiled OpenMP loop, to measure what tiling buys
+            output = generateOutputFileName(inputFileName, "openmp_flat", width);
+            string outputOpenMPFlat = "output/" + output.substr(5, output.length());
+            timesOpenMPFlat[trial] = resizeImage(openMP_ResizeBicubicFlat, inputFileName, outputOpenMPFlat.c_str(), width, newHeight);
+
             // Process using CUDA method
             output = generateOutputFileName(inputFileName, "cuda", width);
             string outputCUDA = "output/" + output.substr(5, output.length());
             double cudaTime = resizeImage(cuda_ResizeBicubic, inputFileName, outputCUDA.c_str(), width, newHeight);
             timesCUDA[trial] = cudaTime;
 
+            // Process using separable two-pass method
+            output = generateOutputFileName(inputFileName, "separable", width);
+            string outputSeparable = "output/" + output.substr(5, output.length());
+            double separableTime = resizeImage(separable_ResizeBicubic, inputFileName, outputSeparable.c_str(), width, newHeight);
+            timesSeparable[trial] = separableTime;
+
+            // Process using vectorized separable method
+            output = generateOutputFileName(inputFileName, "simd", width);
+            string outputSIMD = "output/" + output.substr(5, output.length());
+            double simdTime = resizeImage(simd_ResizeBicubic, inputFileName, outputSIMD.c_str(), width, newHeight);
+            timesSIMD[trial] = simdTime;
+
+            // Process using 8-bit fixed-point method
+            output = generateOutputFileName(inputFileName, "fixed", width);
+            string outputFixed = "output/" + output.substr(5, output.length());
+            double fixedTime = resizeImage(fixedPoint_ResizeBicubic, inputFileName, outputFixed.c_str(), width, newHeight);
+            timesFixed[trial] = fixedTime;
+
+            // Process using Lanczos-2 and Lanczos-3 (different filters, so no MSE against serial)
+            output = generateOutputFileName(inputFileName, "lanczos2", width);
+            string outputLanczos2 = "output/" + output.substr(5, output.length());
+            timesLanczos2[trial] = resizeImage(separable_Resize<Lanczos2Kernel>, inputFileName, outputLanczos2.c_str(), width, newHeight);
+
+            output = generateOutputFileName(inputFileName, "lanczos3", width);
+            string outputLanczos3 = "output/" + output.substr(5, output.length());
+            timesLanczos3[trial] = resizeImage(separable_Resize<Lanczos3Kernel>, inputFileName, outputLanczos3.c_str(), width, newHeight);
+
+            // Process using antialiased bicubic (widened support on downscales)
+            output = generateOutputFileName(inputFileName, "antialias", width);
+            string outputAntialias = "output/" + output.substr(5, output.length());
+            timesAntialias[trial] = resizeImage(separable_AntialiasResize<CatmullRomKernel>, inputFileName, outputAntialias.c_str(), width, newHeight);
+
+            // Process using box pyramid + antialiased bicubic (same as antialiased below 2x downscale)
+            output = generateOutputFileName(inputFileName, "pyramid", width);
+            string outputPyramid = "output/" + output.substr(5, output.length());
+            timesPyramid[trial] = resizeImage(pyramid_ResizeBicubic, inputFileName, outputPyramid.c_str(), width, newHeight);
+
             // Process using Simple method (not bicubic)
             output = generateOutputFileName(inputFileName, "simple", width);
             string outputSimple = "output/" + output.substr(5, output.length());
@@ -153,9 +275,16 @@ void experiment_processImage(const char* inputFileName, int w[]) {
             unsigned char* imgSerial = loadImage(outputSerial.c_str(), originalWidth, originalHeight, originalChannels);
             unsigned char* imgOpenMP = loadImage(outputOpenMP.c_str(), originalWidth, originalHeight, originalChannels);
             unsigned char* imgCUDA = loadImage(outputCUDA.c_str(), originalWidth, originalHeight, originalChannels);
+            unsigned char* imgSeparable = loadImage(outputSeparable.c_str(), originalWidth, originalHeight, originalChannels);
+            unsigned char* imgSIMD = loadImage(outputSIMD.c_str(), originalWidth, originalHeight, originalChannels);
+            unsigned char* imgFixed = loadImage(outputFixed.c_str(), originalWidth, originalHeight, originalChannels);
 
             mseOpenMP[trial] = calculateMSE(imgSerial, imgOpenMP, originalWidth, originalHeight, originalChannels);
             mseCUDA[trial] = calculateMSE(imgSerial, imgCUDA, originalWidth, originalHeight, originalChannels);
+            // separable sums in a different order, so it may differ from serial by rounding only
+            mseSeparable[trial] = calculateMSE(imgSerial, imgSeparable, originalWidth, originalHeight, originalChannels);
+            mseSIMD[trial] = calculateMSE(imgSerial, imgSIMD, originalWidth, originalHeight, originalChannels);
+            mseFixed[trial] = calculateMSE(imgSerial, imgFixed, originalWidth, originalHeight, originalChannels);
 
             // Check if the results are valid
             if (mseOpenMP[trial] > 0 || mseCUDA[trial] > 0) {
@@ -167,31 +296,80 @@ void experiment_processImage(const char* inputFileName, int w[]) {
             stbi_image_free(imgSerial);
             stbi_image_free(imgOpenMP);
             stbi_image_free(imgCUDA);
+            stbi_image_free(imgSeparable);
+            stbi_image_free(imgSIMD);
+            stbi_image_free(imgFixed);
         }
 
         if (validResults) {
             // Calculate averages and performance gains
             double avgSerialTime = accumulate(timesSerial.begin(), timesSerial.end(), 0.0) / numTrials;
             double avgOpenMPTime = accumulate(timesOpenMP.begin(), timesOpenMP.end(), 0.0) / numTrials;
+            double avgOpenMPFlatTime = accumulate(timesOpenMPFlat.begin(), timesOpenMPFlat.end(), 0.0) / numTrials;
             double avgCUDA = accumulate(timesCUDA.begin(), timesCUDA.end(), 0.0) / numTrials;
+            double avgSeparableTime = accumulate(timesSeparable.begin(), timesSeparable.end(), 0.0) / numTrials;
+            double avgSIMDTime = accumulate(timesSIMD.begin(), timesSIMD.end(), 0.0) / numTrials;
+            double avgFixedTime = accumulate(timesFixed.begin(), timesFixed.end(), 0.0) / numTrials;
+            double avgLanczos2Time = accumulate(timesLanczos2.begin(), timesLanczos2.end(), 0.0) / numTrials;
+            double avgLanczos3Time = accumulate(timesLanczos3.begin(), timesLanczos3.end(), 0.0) / numTrials;
+            double avgAntialiasTime = accumulate(timesAntialias.begin(), timesAntialias.end(), 0.0) / numTrials;
+            double avgPyramidTime = accumulate(timesPyramid.begin(), timesPyramid.end(), 0.0) / numTrials;
 
             double avgMSEOpenMP = accumulate(mseOpenMP.begin(), mseOpenMP.end(), 0.0) / numTrials;
             double avgMSECuda = accumulate(mseCUDA.begin(), mseCUDA.end(), 0.0) / numTrials;
+            double avgMSESeparable = accumulate(mseSeparable.begin(), mseSeparable.end(), 0.0) / numTrials;
+            double avgMSESIMD = accumulate(mseSIMD.begin(), mseSIMD.end(), 0.0) / numTrials;
+            double avgMSEFixed = accumulate(mseFixed.begin(), mseFixed.end(), 0.0) / numTrials;
 
             double performanceGainOpenMP = avgSerialTime / avgOpenMPTime;
             double performanceGainCUDA = avgSerialTime / avgCUDA;
+            double performanceGainSeparable = avgSerialTime / avgSeparableTime;
+            double performanceGainSIMD = avgSerialTime / avgSIMDTime;
+            double performanceGainFixed = avgSerialTime / avgFixedTime;
+
+            // Throughput in output megapixels per second
+            double megapixels = static_cast<double>(width) * newHeight / 1e6;
 
             cout << fixed << setprecision(4);
             cout << endl << "Width: " << width << endl;
-            cout << "Serial average time: " << avgSerialTime << " seconds." << endl;
-            cout << "OpenMP average time: " << avgOpenMPTime << " seconds. Performance gain: " << performanceGainOpenMP << endl;
-            cout << "CUDA average time: " << avgCUDA << " seconds. Performance gain: " << performanceGainCUDA << endl;
+            cout << "Serial average time: " << avgSerialTime << " seconds. "
+                << megapixels / avgSerialTime << " MPix/s" << endl;
+            cout << "OpenMP average time: " << avgOpenMPTime << " seconds. Performance gain: " << performanceGainOpenMP << ". "
+                << megapixels / avgOpenMPTime << " MPix/s" << endl;
+            cout << "OpenMP flat loop average time: " << avgOpenMPFlatTime << " seconds. Tiled speedup over flat: "
+                << avgOpenMPFlatTime / avgOpenMPTime << endl;
+            cout << "CUDA average time: " << avgCUDA << " seconds. Performance gain: " << performanceGainCUDA << ". "
+                << megapixels / avgCUDA << " MPix/s" << endl;
+            cout << "Separable average time: " << avgSeparableTime << " seconds. Performance gain: " << performanceGainSeparable << ". "
+                << megapixels / avgSeparableTime << " MPix/s (MSE vs serial: " << avgMSESeparable << ")" << endl;
+            cout << "SIMD (" << simdLevelName(simd_ActiveLevel()) << ") average time: " << avgSIMDTime << " seconds. Performance gain: " << performanceGainSIMD << ". "
+                << megapixels / avgSIMDTime << " MPix/s (MSE vs serial: " << avgMSESIMD << ")" << endl;
+            cout << "Fixed-point average time: " << avgFixedTime << " seconds. Performance gain: " << performanceGainFixed << ". "
+                << megapixels / avgFixedTime << " MPix/s (MSE vs serial: " << avgMSEFixed << ")" << endl;
+            cout << "Lanczos-2 (separable) average time: " << avgLanczos2Time << " seconds. "
+                << megapixels / avgLanczos2Time << " MPix/s" << endl;
+            cout << "Lanczos-3 (separable) average time: " << avgLanczos3Time << " seconds. "
+                << megapixels / avgLanczos3Time << " MPix/s" << endl;
+            cout << "Antialiased (separable) average time: " << avgAntialiasTime << " seconds. "
+                << megapixels / avgAntialiasTime << " MPix/s" << endl;
+            cout << "Pyramid average time: " << avgPyramidTime << " seconds. "
+                << megapixels / avgPyramidTime << " MPix/s" << endl;
             cout << endl << "------------------------------------------------------------------------" << endl;
             serial_exec_time[ctr] = avgSerialTime;
             openmp_exec_time[ctr] = avgOpenMPTime;
             openmp_pg_result[ctr] = performanceGainOpenMP;
             cuda_exec_time[ctr] = avgCUDA;
             cuda_pg_result[ctr] = performanceGainCUDA;
+            separable_exec_time[ctr] = avgSeparableTime;
+            separable_pg_result[ctr] = performanceGainSeparable;
+            simd_exec_time[ctr] = avgSIMDTime;
+            simd_pg_result[ctr] = performanceGainSIMD;
+            fixed_exec_time[ctr] = avgFixedTime;
+            fixed_pg_result[ctr] = performanceGainFixed;
+            lanczos2_exec_time[ctr] = avgLanczos2Time;
+            lanczos3_exec_time[ctr] = avgLanczos3Time;
+            antialias_exec_time[ctr] = avgAntialiasTime;
+            pyramid_exec_time[ctr] = avgPyramidTime;
         }
         ctr = ctr + 1;
     }
@@ -218,10 +396,17 @@ void experiment_processImage(const char* inputFileName, int w[]) {
     gp << "set ylabel 'Execution Time (s)'\n";
     gp << "set xlabel 'Image Width'\n";
     gp << "set style data linespoints\n";
-    gp << "plot '-' using 1:2 with linespoints title 'Serial', '-' using 1:2 with linespoints title 'OpenMP', '-' using 1:2 with linespoints title 'CUDA'\n";
+    gp << "plot '-' using 1:2 with linespoints title 'Serial', '-' using 1:2 with linespoints title 'OpenMP', '-' using 1:2 with linespoints title 'CUDA', '-' using 1:2 with linespoints title 'Separable', '-' using 1:2 with linespoints title 'SIMD', '-' using 1:2 with linespoints title 'Fixed-point', '-' using 1:2 with linespoints title 'Lanczos-2', '-' using 1:2 with linespoints title 'Lanczos-3', '-' using 1:2 with linespoints title 'Antialiased', '-' using 1:2 with linespoints title 'Pyramid'\n";
     gp.send1d(boost::make_tuple(widths, serial_exec_time));
     gp.send1d(boost::make_tuple(widths, openmp_exec_time));
     gp.send1d(boost::make_tuple(widths, cuda_exec_time));
+    gp.send1d(boost::make_tuple(widths, separable_exec_time));
+    gp.send1d(boost::make_tuple(widths, simd_exec_time));
+    gp.send1d(boost::make_tuple(widths, fixed_exec_time));
+    gp.send1d(boost::make_tuple(widths, lanczos2_exec_time));
+    gp.send1d(boost::make_tuple(widths, lanczos3_exec_time));
+    gp.send1d(boost::make_tuple(widths, antialias_exec_time));
+    gp.send1d(boost::make_tuple(widths, pyramid_exec_time));
 
     // Save line plot for performance gain comparison as PNG
     gp << "set output 'plot/performance_gain_lineplot.png'\n"; \
@@ -239,6 +424,1285 @@ void experiment_processImage(const char* inputFileName, int w[]) {
     stbi_image_free(imgOriginal);
 }
 
+// Function to compare the box pyramid against the single-pass antialiased filter on a large downscale.
+// The input is first upscaled to srcWidth so any image can drive e.g. a 12000 -> 750 reduction.
+void downscale_processImage(const char* inputFileName, int srcWidth, int dstWidth) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int width, height, channels;
+    unsigned char* img = loadImage(inputFileName, width, height, channels);
+    if (!img) {
+        return;
+    }
+
+    double aspectRatio = static_cast<double>(height) / static_cast<double>(width);
+    int srcHeight = static_cast<int>(srcWidth * aspectRatio);
+    int dstHeight = static_cast<int>(dstWidth * aspectRatio);
+
+    unsigned char* src = new unsigned char[(size_t)srcWidth * srcHeight * channels];
+    simd_ResizeBicubic(img, width, height, channels, src, srcWidth, srcHeight);
+    stbi_image_free(img);
+
+    unsigned char* dstAntialias = new unsigned char[(size_t)dstWidth * dstHeight * channels];
+    unsigned char* dstPyramid = new unsigned char[(size_t)dstWidth * dstHeight * channels];
+
+    const int numTrials = 5;
+    vector<double> timesAntialias(numTrials);
+    vector<double> timesPyramid(numTrials);
+
+    for (int trial = 0; trial < numTrials; ++trial) {
+        double start_time = omp_get_wtime();
+        separable_AntialiasResize<CatmullRomKernel>(src, srcWidth, srcHeight, channels, dstAntialias, dstWidth, dstHeight);
+        timesAntialias[trial] = omp_get_wtime() - start_time;
+
+        start_time = omp_get_wtime();
+        pyramid_ResizeBicubic(src, srcWidth, srcHeight, channels, dstPyramid, dstWidth, dstHeight);
+        timesPyramid[trial] = omp_get_wtime() - start_time;
+    }
+
+    double avgAntialiasTime = accumulate(timesAntialias.begin(), timesAntialias.end(), 0.0) / numTrials;
+    double avgPyramidTime = accumulate(timesPyramid.begin(), timesPyramid.end(), 0.0) / numTrials;
+
+    // Scratch memory: the single-pass filter keeps a srcHeight x dstWidth float intermediate
+    double antialiasMB = (double)srcHeight * dstWidth * channels * sizeof(float) / (1024.0 * 1024.0);
+    double pyramidMB = (double)pyramid_ScratchBytes(srcWidth, srcHeight, channels, dstWidth, dstHeight) / (1024.0 * 1024.0);
+
+    // Input megapixels per second, since the work scales with the source
+    double megapixels = static_cast<double>(srcWidth) * srcHeight / 1e6;
+
+    cout << fixed << setprecision(4);
+    cout << "Downscale " << srcWidth << "x" << srcHeight << " -> " << dstWidth << "x" << dstHeight << endl;
+    cout << "Antialiased (single pass) average time: " << avgAntialiasTime << " seconds. "
+        << megapixels / avgAntialiasTime << " MPix/s. Scratch: " << antialiasMB << " MB" << endl;
+    cout << "Pyramid average time: " << avgPyramidTime << " seconds. Performance gain: " << avgAntialiasTime / avgPyramidTime << ". "
+        << megapixels / avgPyramidTime << " MPix/s. Scratch: " << pyramidMB << " MB" << endl;
+    cout << "MSE pyramid vs single pass: " << calculateMSE(dstAntialias, dstPyramid, dstWidth, dstHeight, channels) << endl;
+
+    string output = generateOutputFileName(inputFileName, "pyramid", dstWidth);
+    string outputPyramid = "output/" + output.substr(5, output.length());
+    saveImage(outputPyramid.c_str(), dstPyramid, dstWidth, dstHeight, channels);
+
+    delete[] src;
+    delete[] dstAntialias;
+    delete[] dstPyramid;
+}
+
+// Average microseconds per call of resizeFunc over the given number of calls, after one warm-up call
+double timePerCall(void (*resizeFunc)(unsigned char*, int, int, int, unsigned char*, int, int),
+    unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight, int calls) {
+    resizeFunc(src, srcWidth, srcHeight, channels, dst, dstWidth, dstHeight);
+    double start_time = omp_get_wtime();
+    for (int i = 0; i < calls; ++i) {
+        resizeFunc(src, srcWidth, srcHeight, channels, dst, dstWidth, dstHeight);
+    }
+    return (omp_get_wtime() - start_time) / calls * 1e6;
+}
+
+// Function to compare per-call overhead of the persistent thread pool against OpenMP on small outputs
+void overhead_processImage(const char* inputFileName) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int width, height, channels;
+    unsigned char* img = loadImage(inputFileName, width, height, channels);
+    if (!img) {
+        return;
+    }
+
+    cout << "Thread pool: " << ThreadPool::instance().workerCount() << " workers + caller, OpenMP: "
+        << omp_get_max_threads() << " threads" << endl;
+
+    int sizes[] = { 256, 64 };
+    for (int size : sizes) {
+        // similar total work per size, many more calls for the small one
+        int calls = size >= 256 ? 200 : 3200;
+        unsigned char* dst = new unsigned char[(size_t)size * size * channels];
+
+        double openmpUs = timePerCall(openMP_ResizeBicubic, img, width, height, channels, dst, size, size, calls);
+        double poolUs = timePerCall(pool_ResizeBicubic, img, width, height, channels, dst, size, size, calls);
+        double simpleUs = timePerCall(simple_Resize, img, width, height, channels, dst, size, size, calls);
+        double poolSimpleUs = timePerCall(pool_SimpleResize, img, width, height, channels, dst, size, size, calls);
+
+        cout << fixed << setprecision(2);
+        cout << endl << "Output: " << size << "x" << size << " (" << calls << " calls)" << endl;
+        cout << "Bicubic  OpenMP: " << openmpUs << " us/call, pool: " << poolUs << " us/call. Speedup: " << openmpUs / poolUs << endl;
+        cout << "Simple   OpenMP: " << simpleUs << " us/call, pool: " << poolSimpleUs << " us/call. Speedup: " << simpleUs / poolSimpleUs << endl;
+
+        delete[] dst;
+    }
+
+    stbi_image_free(img);
+}
+
+// Function to compare the batch scheduler against looping over openMP_ResizeBicubic on a mixed-size corpus
+void batch_processImage(const char* inputFileName) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int width, height, channels;
+    unsigned char* img = loadImage(inputFileName, width, height, channels);
+    if (!img) {
+        return;
+    }
+    double aspectRatio = static_cast<double>(height) / static_cast<double>(width);
+
+    // thumbnails, previews and a couple of large renders from the same source
+    vector<int> corpusWidths;
+    corpusWidths.insert(corpusWidths.end(), 48, 64);
+    corpusWidths.insert(corpusWidths.end(), 12, 256);
+    corpusWidths.insert(corpusWidths.end(), 4, 750);
+    corpusWidths.insert(corpusWidths.end(), 2, 3000);
+
+    vector<ResizeJob> jobs;
+    double megapixels = 0;
+    for (int w : corpusWidths) {
+        int h = max(1, static_cast<int>(w * aspectRatio));
+        ResizeJob job = { img, width, height, channels, new unsigned char[(size_t)w * h * channels], w, h };
+        jobs.push_back(job);
+        megapixels += static_cast<double>(w) * h / 1e6;
+    }
+
+    const int numTrials = 5;
+    vector<double> timesLoop(numTrials);
+    vector<double> timesBatch(numTrials);
+    BatchStrategy strategy = BATCH_INTER_IMAGE;
+
+    for (int trial = 0; trial < numTrials; ++trial) {
+        double start_time = omp_get_wtime();
+        for (const ResizeJob& job : jobs) {
+            openMP_ResizeBicubic(job.src, job.srcWidth, job.srcHeight, job.channels, job.dst, job.dstWidth, job.dstHeight);
+        }
+        timesLoop[trial] = omp_get_wtime() - start_time;
+
+        start_time = omp_get_wtime();
+        strategy = batch_ResizeBicubic(jobs);
+        timesBatch[trial] = omp_get_wtime() - start_time;
+    }
+
+    double avgLoopTime = accumulate(timesLoop.begin(), timesLoop.end(), 0.0) / numTrials;
+    double avgBatchTime = accumulate(timesBatch.begin(), timesBatch.end(), 0.0) / numTrials;
+
+    cout << fixed << setprecision(4);
+    cout << "Corpus: " << jobs.size() << " images, " << megapixels << " output MPix" << endl;
+    cout << "OpenMP loop average time: " << avgLoopTime << " seconds. "
+        << jobs.size() / avgLoopTime << " images/s, " << megapixels / avgLoopTime << " MPix/s" << endl;
+    cout << "Batch (" << batchStrategyName(strategy) << ") average time: " << avgBatchTime << " seconds. Performance gain: "
+        << avgLoopTime / avgBatchTime << ". " << jobs.size() / avgBatchTime << " images/s, " << megapixels / avgBatchTime << " MPix/s" << endl;
+
+    for (ResizeJob& job : jobs) {
+        delete[] job.dst;
+    }
+    stbi_image_free(img);
+}
+
+// Function to stream-resize the input into a PAM file row by row, so the output never sits in memory whole
+void stream_processImage(const char* inputFileName, int newWidth) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int width, height, channels;
+    unsigned char* img = loadImage(inputFileName, width, height, channels);
+    if (!img) {
+        return;
+    }
+    int newHeight = static_cast<int>(newWidth * (static_cast<double>(height) / width));
+
+    string output = generateOutputFileName(inputFileName, "stream", newWidth);
+    string outputStream = "output/" + output.substr(5, output.find_last_of(".") - 5) + ".pam";
+    ofstream file(outputStream, ios::binary);
+    if (!file) {
+        cerr << "Failed to open output: " << outputStream << endl;
+        stbi_image_free(img);
+        return;
+    }
+    file << "P7\nWIDTH " << newWidth << "\nHEIGHT " << newHeight << "\nDEPTH " << channels << "\nMAXVAL 255\nENDHDR\n";
+
+    size_t srcStride = (size_t)width * channels;
+    size_t dstStride = (size_t)newWidth * channels;
+
+    double start_time = omp_get_wtime();
+    bool ok = stream_ResizeBicubic(width, height, channels, newWidth, newHeight,
+        [&](int y, unsigned char* row) {
+            memcpy(row, &img[y * srcStride], srcStride);
+            return true;
+        },
+        [&](int, const unsigned char* row) {
+            file.write((const char*)row, dstStride);
+            return (bool)file;
+        });
+    double run_time = omp_get_wtime() - start_time;
+
+    const ResizePlan& plan = *getResizePlan(width, height, newWidth, newHeight);
+    double streamMB = ((double)stream_RingRows(plan) * dstStride * sizeof(float) + srcStride + dstStride) / (1024.0 * 1024.0);
+    double bufferedMB = ((double)height * dstStride * sizeof(float) + (double)newHeight * dstStride) / (1024.0 * 1024.0);
+
+    cout << fixed << setprecision(4);
+    cout << "Streamed " << width << "x" << height << " -> " << newWidth << "x" << newHeight << " to " << outputStream
+        << (ok ? "" : " (failed)") << endl;
+    cout << "Time: " << run_time << " seconds. " << static_cast<double>(newWidth) * newHeight / 1e6 / run_time << " MPix/s" << endl;
+    cout << "Working memory: " << streamMB << " MB streaming vs " << bufferedMB << " MB for separable with a full output buffer" << endl;
+
+    stbi_image_free(img);
+}
+
+// Function to compare resize-then-encode in a loop against submitting every resize to a
+// ResizeEngine and encoding each output while the remaining resizes are still running
+void async_processImage(const char* inputFileName, int w[]) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int width, height, channels;
+    unsigned char* img = loadImage(inputFileName, width, height, channels);
+    if (!img) {
+        return;
+    }
+    double aspectRatio = static_cast<double>(height) / static_cast<double>(width);
+
+    // each requested width four times, as if several clients asked for it
+    vector<ResizeJob> jobs;
+    for (int i = 0; i < 5 && w[i] != 0; ++i) {
+        int newHeight = static_cast<int>(w[i] * aspectRatio);
+        for (int copy = 0; copy < 4; ++copy) {
+            ResizeJob job = { img, width, height, channels, new unsigned char[(size_t)w[i] * newHeight * channels], w[i], newHeight };
+            jobs.push_back(job);
+        }
+    }
+
+    vector<string> outputs;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        string output = generateOutputFileName(inputFileName, "async" + to_string(i % 4), jobs[i].dstWidth);
+        outputs.push_back("output/" + output.substr(5, output.length()));
+    }
+
+    double start_time = omp_get_wtime();
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const ResizeJob& job = jobs[i];
+        openMP_ResizeBicubic(job.src, job.srcWidth, job.srcHeight, job.channels, job.dst, job.dstWidth, job.dstHeight);
+        saveImage(outputs[i].c_str(), job.dst, job.dstWidth, job.dstHeight, job.channels);
+    }
+    double syncTime = omp_get_wtime() - start_time;
+
+    start_time = omp_get_wtime();
+    {
+        int workers = max(1, omp_get_max_threads() - 1);
+        ResizeEngine engine(serial_ResizeBicubic, workers, 8);
+
+        vector<future<ResizeResult>> results;
+        for (const ResizeJob& job : jobs) {
+            results.push_back(engine.submit(job));
+        }
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            if (results[i].get() == RESIZE_COMPLETED) {
+                saveImage(outputs[i].c_str(), jobs[i].dst, jobs[i].dstWidth, jobs[i].dstHeight, jobs[i].channels);
+            }
+        }
+    }
+    double asyncTime = omp_get_wtime() - start_time;
+
+    cout << fixed << setprecision(4);
+    cout << jobs.size() << " resize + PNG encode jobs" << endl;
+    cout << "OpenMP resize then encode: " << syncTime << " seconds" << endl;
+    cout << "ResizeEngine (serial executor) with encode overlapped: " << asyncTime << " seconds. Performance gain: "
+        << syncTime / asyncTime << endl;
+
+    for (ResizeJob& job : jobs) {
+        delete[] job.dst;
+    }
+    stbi_image_free(img);
+}
+
+// stbi_write_png_to_func callback appending the encoded bytes to a vector
+static void appendToBuffer(void* context, void* data, int size) {
+    vector<unsigned char>* buffer = (vector<unsigned char>*)context;
+    buffer->insert(buffer->end(), (unsigned char*)data, (unsigned char*)data + size);
+}
+
+// Function to run a file-to-file batch with blocking stbi_load / stbi_write_png, then again with
+// AsyncFileIO prefetching the next input and writing the previous output while the current one resizes
+void fileBatch_processImages(const vector<string>& inputFileNames, int w[]) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    struct FileJob {
+        string input, output;
+        int width;
+    };
+    vector<FileJob> jobs;
+    for (const string& input : inputFileNames) {
+        for (int i = 0; i < 5 && w[i] != 0; ++i) {
+            string output = generateOutputFileName(input, "batchio", w[i]);
+            jobs.push_back(FileJob{ input, "output/" + output.substr(5, output.length()), w[i] });
+        }
+    }
+    if (jobs.empty()) {
+        return;
+    }
+
+    double start_time = omp_get_wtime();
+    for (const FileJob& job : jobs) {
+        int width, height, channels;
+        unsigned char* img = loadImage(job.input.c_str(), width, height, channels);
+        if (!img) {
+            continue;
+        }
+        int newHeight = static_cast<int>(job.width * (static_cast<double>(height) / width));
+        vector<unsigned char> resized((size_t)job.width * newHeight * channels);
+        openMP_ResizeBicubic(img, width, height, channels, resized.data(), job.width, newHeight);
+        saveImage(job.output.c_str(), resized.data(), job.width, newHeight, channels);
+        stbi_image_free(img);
+    }
+    double blockingTime = omp_get_wtime() - start_time;
+
+    start_time = omp_get_wtime();
+    unique_ptr<AsyncFileIO> io = AsyncFileIO::create();
+    {
+        vector<future<bool>> writes;
+        future<vector<unsigned char>> nextRead = io->readFile(jobs[0].input);
+
+        for (size_t j = 0; j < jobs.size(); ++j) {
+            vector<unsigned char> encoded = nextRead.get();
+            if (j + 1 < jobs.size()) {
+                nextRead = io->readFile(jobs[j + 1].input);
+            }
+
+            int width, height, channels;
+            unsigned char* img = stbi_load_from_memory(encoded.data(), (int)encoded.size(), &width, &height, &channels, 0);
+            if (!img) {
+                cerr << "Failed to load image: " << jobs[j].input << endl;
+                continue;
+            }
+            int newHeight = static_cast<int>(jobs[j].width * (static_cast<double>(height) / width));
+            vector<unsigned char> resized((size_t)jobs[j].width * newHeight * channels);
+            openMP_ResizeBicubic(img, width, height, channels, resized.data(), jobs[j].width, newHeight);
+            stbi_image_free(img);
+
+            vector<unsigned char> png;
+            stbi_write_png_to_func(appendToBuffer, &png, jobs[j].width, newHeight, channels, resized.data(), jobs[j].width * channels);
+            writes.push_back(io->writeFile(jobs[j].output, move(png)));
+        }
+
+        for (future<bool>& write : writes) {
+            if (!write.get()) {
+                cerr << "Failed to save an image of the batch" << endl;
+            }
+        }
+    }
+    double overlappedTime = omp_get_wtime() - start_time;
+
+    cout << fixed << setprecision(4);
+    cout << jobs.size() << " file-to-file jobs, I/O backend: " << io->backendName() << endl;
+    cout << "Blocking load/resize/save: " << blockingTime << " seconds" << endl;
+    cout << "Overlapped I/O: " << overlappedTime << " seconds. Performance gain: " << blockingTime / overlappedTime << endl;
+}
+
+// Function to resize with the backend auto_Choose picks at each width, against plain OpenMP
+void auto_processImage(const char* inputFileName, int w[]) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int originalWidth, originalHeight, originalChannels;
+    unsigned char* imgOriginal = loadImage(inputFileName, originalWidth, originalHeight, originalChannels);
+    if (!imgOriginal) {
+        return;
+    }
+    double aspectRatio = static_cast<double>(originalHeight) / static_cast<double>(originalWidth);
+    stbi_image_free(imgOriginal);
+
+    const int numTrials = 5;
+    for (int i = 0; i < 5 && w[i] != 0; ++i) {
+        int width = w[i];
+        int newHeight = static_cast<int>(width * aspectRatio);
+        ResizeChoice choice = auto_Choose(width, newHeight, originalChannels);
+
+        string output = generateOutputFileName(inputFileName, "auto", width);
+        string outputAuto = "output/" + output.substr(5, output.length());
+        output = generateOutputFileName(inputFileName, "openmp", width);
+        string outputOpenMP = "output/" + output.substr(5, output.length());
+
+        vector<double> timesAuto(numTrials);
+        vector<double> timesOpenMP(numTrials);
+        for (int trial = 0; trial < numTrials; ++trial) {
+            timesAuto[trial] = resizeImage(auto_ResizeBicubic, inputFileName, outputAuto.c_str(), width, newHeight);
+            timesOpenMP[trial] = resizeImage(openMP_ResizeBicubic, inputFileName, outputOpenMP.c_str(), width, newHeight);
+        }
+        double avgAutoTime = accumulate(timesAuto.begin(), timesAuto.end(), 0.0) / numTrials;
+        double avgOpenMPTime = accumulate(timesOpenMP.begin(), timesOpenMP.end(), 0.0) / numTrials;
+
+        cout << fixed << setprecision(4);
+        cout << endl << "Width: " << width << " -> " << resizeChoiceName(choice) << endl;
+        cout << "Auto average time: " << avgAutoTime << " seconds. OpenMP average time: " << avgOpenMPTime
+            << " seconds. Performance gain: " << avgOpenMPTime / avgAutoTime << endl;
+    }
+}
+
+// Function to sweep OpenMP thread counts and affinity policies at each width. Writes one CSV row per
+// (width, policy, threads) to output/scaling.csv and an Amdahl serial-fraction fit per (width, policy)
+// to output/scaling_amdahl.csv, both headed by the host's CPU counts and SIMD level.
+void scaling_processImage(const char* inputFileName, int w[]) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int width, height, channels;
+    unsigned char* img = loadImage(inputFileName, width, height, channels);
+    if (!img) {
+        return;
+    }
+    double aspectRatio = static_cast<double>(height) / static_cast<double>(width);
+
+    vector<LogicalCpu> cpus = detectCpuTopology();
+    int logicalCpus = max((int)cpus.size(), 1);
+    int cores = max(physicalCoreCount(cpus), 1);
+
+    // every count up to 16 threads, powers of two beyond that
+    vector<int> threadCounts;
+    for (int t = 1; t <= logicalCpus; t = t < 16 ? t + 1 : t * 2) {
+        threadCounts.push_back(t);
+    }
+    if (threadCounts.back() != logicalCpus) {
+        threadCounts.push_back(logicalCpus);
+    }
+
+    string host = "# host logicalCpus=" + to_string(logicalCpus) + " cores=" + to_string(cores) + " simd=" + simdLevelName(simd_ActiveLevel());
+    ofstream csv("output/scaling.csv");
+    ofstream amdahlCsv("output/scaling_amdahl.csv");
+    csv << host << endl << "width,height,policy,threads,seconds,speedup,efficiency" << endl;
+    amdahlCsv << host << endl << "width,height,policy,serialFraction,maxSpeedup" << endl;
+
+    const AffinityPolicy policies[] = { AFFINITY_NONE, AFFINITY_COMPACT, AFFINITY_SCATTER, AFFINITY_NO_SMT };
+    const int numTrials = 3;
+    int defaultThreads = omp_get_max_threads();
+
+    cout << fixed << setprecision(4);
+    cout << "Host: " << logicalCpus << " logical CPUs, " << cores << " cores" << endl;
+
+    for (int i = 0; i < 5 && w[i] != 0; ++i) {
+        int newWidth = w[i];
+        int newHeight = static_cast<int>(newWidth * aspectRatio);
+        vector<unsigned char> dst((size_t)newWidth * newHeight * channels);
+        const ResizePlan& plan = *getResizePlan(width, height, newWidth, newHeight);
+        cout << endl << "Width: " << newWidth << endl;
+
+        for (AffinityPolicy policy : policies) {
+            double singleThreadTime = 0;
+            double fitNumerator = 0, fitDenominator = 0;
+
+            for (int threads : threadCounts) {
+                // without SMT there is one usable CPU per core
+                if (policy == AFFINITY_NO_SMT && threads > cores) {
+                    break;
+                }
+
+                omp_set_num_threads(threads);
+                pinOpenMPTeam(threads, policy);
+
+                double fastest = 1e30;
+                for (int trial = 0; trial < numTrials; ++trial) {
+                    double start_time = omp_get_wtime();
+                    openMP_ResizeBicubic(plan, img, channels, dst.data());
+                    fastest = min(fastest, omp_get_wtime() - start_time);
+                }
+                unpinOpenMPTeam(threads);
+
+                if (threads == 1) {
+                    singleThreadTime = fastest;
+                }
+                double speedup = singleThreadTime / fastest;
+                double efficiency = speedup / threads;
+
+                // Amdahl: t(n) / t(1) = f + (1 - f) / n, least squares in f
+                double inverse = 1.0 / threads;
+                fitNumerator += (fastest / singleThreadTime - inverse) * (1.0 - inverse);
+                fitDenominator += (1.0 - inverse) * (1.0 - inverse);
+
+                csv << newWidth << "," << newHeight << "," << affinityPolicyName(policy) << "," << threads << ","
+                    << fastest << "," << speedup << "," << efficiency << endl;
+                cout << "  " << affinityPolicyName(policy) << " x" << threads << ": " << fastest << " seconds. Speedup: "
+                    << speedup << ", efficiency: " << efficiency << endl;
+            }
+
+            // a single data point (one CPU) says nothing about the serial fraction
+            if (fitDenominator == 0) {
+                amdahlCsv << newWidth << "," << newHeight << "," << affinityPolicyName(policy) << ",n/a,n/a" << endl;
+                continue;
+            }
+            double serialFraction = min(max(fitNumerator / fitDenominator, 0.0), 1.0);
+            amdahlCsv << newWidth << "," << newHeight << "," << affinityPolicyName(policy) << "," << serialFraction << ","
+                << (serialFraction > 0 ? to_string(1.0 / serialFraction) : string("inf")) << endl;
+            cout << "  " << affinityPolicyName(policy) << " Amdahl serial fraction: " << serialFraction << endl;
+        }
+    }
+
+    omp_set_num_threads(defaultThreads);
+    cout << endl << "Scaling data written to output/scaling.csv and output/scaling_amdahl.csv" << endl;
+    stbi_image_free(img);
+}
+
+// Function to compare NUMA-aware placement against the current buffers at each width. Layouts:
+// the tiled OpenMP backend on the stbi_load source and a new[] output (current), the same buffers
+// with node-banded pinned threads, and both buffers placed band by band on the nodes that use
+// them, by parallel first touch and, with libnuma, by binding. Rows go to output/numa.csv.
+void numa_processImage(const char* inputFileName, int w[]) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int width, height, channels;
+    unsigned char* img = loadImage(inputFileName, width, height, channels);
+    if (!img) {
+        return;
+    }
+    double aspectRatio = static_cast<double>(height) / static_cast<double>(width);
+    size_t srcRowBytes = (size_t)width * channels;
+
+    NumaTeam team = numa_MakeTeam();
+    vector<LogicalCpu> cpus = detectCpuTopology();
+    string host = "# host logicalCpus=" + to_string(cpus.size()) + " nodes=" + to_string(numaNodeCount(cpus))
+        + " threads=" + to_string(team.threads()) + " libnuma=" + (numa_BindAvailable() ? "yes" : "no");
+    ofstream csv("output/numa.csv");
+    csv << host << endl << "width,height,layout,seconds,speedup" << endl;
+
+    cout << fixed << setprecision(4);
+    cout << "Host: " << cpus.size() << " logical CPUs, " << numaNodeCount(cpus) << " NUMA node(s), threads per node:";
+    for (int i = 0; i < team.nodes(); ++i) {
+        cout << " " << team.nodeIds[i] << ":" << team.nodeThreads[i];
+    }
+    cout << endl;
+    if (team.nodes() < 2) {
+        cout << "Single node: every layout reads local memory, expect no gain" << endl;
+    }
+
+    const int numTrials = 3;
+    for (int i = 0; i < 5 && w[i] != 0; ++i) {
+        int newWidth = w[i];
+        int newHeight = static_cast<int>(newWidth * aspectRatio);
+        size_t dstRowBytes = (size_t)newWidth * channels;
+        size_t dstBytes = dstRowBytes * newHeight;
+        const ResizePlan& plan = *getResizePlan(width, height, newWidth, newHeight);
+        vector<int> dstBands = numa_RowBands(team, newHeight);
+        vector<int> srcBands = numa_SourceBands(plan, dstBands);
+
+        unsigned char* reference = new unsigned char[dstBytes];
+        double fastest = 1e30;
+        for (int trial = 0; trial < numTrials; ++trial) {
+            double start_time = omp_get_wtime();
+            openMP_ResizeBicubic(plan, img, channels, reference);
+            fastest = min(fastest, omp_get_wtime() - start_time);
+        }
+        double currentTime = fastest;
+
+        cout << endl << "Width: " << newWidth << endl;
+        cout << "  current (stbi source, new[] output): " << currentTime << " seconds" << endl;
+        csv << newWidth << "," << newHeight << ",current," << currentTime << ",1" << endl;
+
+        // the same buffers, only the threads and tile bands follow the nodes
+        unsigned char* pinnedDst = new unsigned char[dstBytes];
+        fastest = 1e30;
+        for (int trial = 0; trial < numTrials; ++trial) {
+            double start_time = omp_get_wtime();
+            numa_ResizeBicubic(plan, team, img, channels, pinnedDst);
+            fastest = min(fastest, omp_get_wtime() - start_time);
+        }
+        bool match = memcmp(reference, pinnedDst, dstBytes) == 0;
+        cout << "  pinned bands: " << fastest << " seconds. Performance gain: " << currentTime / fastest
+            << (match ? "" : " (output differs)") << endl;
+        csv << newWidth << "," << newHeight << ",pinned," << fastest << "," << currentTime / fastest << endl;
+        delete[] pinnedDst;
+
+        const NumaPlacement placements[] = { NUMA_FIRST_TOUCH, NUMA_BIND };
+        for (NumaPlacement placement : placements) {
+            const char* layout = placement == NUMA_BIND ? "bind" : "first-touch";
+            if (placement == NUMA_BIND && !numa_BindAvailable()) {
+                cout << "  " << layout << ": n/a (built without USE_LIBNUMA or no kernel NUMA support)" << endl;
+                csv << newWidth << "," << newHeight << "," << layout << ",n/a,n/a" << endl;
+                continue;
+            }
+
+            NumaBuffer src(srcRowBytes * height);
+            NumaBuffer dst(dstBytes);
+            src.place(team, srcBands, srcRowBytes, placement);
+            dst.place(team, dstBands, dstRowBytes, placement);
+            numa_CopyRows(team, srcBands, img, src.data(), srcRowBytes);
+
+            fastest = 1e30;
+            for (int trial = 0; trial < numTrials; ++trial) {
+                double start_time = omp_get_wtime();
+                numa_ResizeBicubic(plan, team, src.data(), channels, dst.data());
+                fastest = min(fastest, omp_get_wtime() - start_time);
+            }
+            match = memcmp(reference, dst.data(), dstBytes) == 0;
+            cout << "  " << layout << ": " << fastest << " seconds. Performance gain: " << currentTime / fastest
+                << (match ? "" : " (output differs)") << endl;
+            csv << newWidth << "," << newHeight << "," << layout << "," << fastest << "," << currentTime / fastest << endl;
+        }
+
+        delete[] reference;
+    }
+
+    cout << endl << "NUMA data written to output/numa.csv" << endl;
+    stbi_image_free(img);
+}
+
+// Mutex-protected bounded deque with the MpmcQueue interface, the baseline of the contention benchmark
+template<typename T>
+class LockedQueue {
+public:
+    explicit LockedQueue(size_t capacity) : capacity(capacity) {}
+
+    bool tryPush(T&& value) {
+        lock_guard<mutex> lock(queueMutex);
+        if (items.size() >= capacity) {
+            return false;
+        }
+        items.push_back(move(value));
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        lock_guard<mutex> lock(queueMutex);
+        if (items.empty()) {
+            return false;
+        }
+        value = move(items.front());
+        items.pop_front();
+        return true;
+    }
+
+private:
+    size_t capacity;
+    deque<T> items;
+    mutex queueMutex;
+};
+
+// Millions of items per second moved through a 1024-slot queue by the given producer and consumer threads
+template<typename Queue>
+static double queueThroughput(int producers, int consumers, int items) {
+    Queue queue(1024);
+    atomic<int> consumed(0);
+    vector<thread> threads;
+
+    double start_time = omp_get_wtime();
+    for (int p = 0; p < producers; ++p) {
+        threads.push_back(thread([&queue, p, producers, items] {
+            for (int i = p; i < items; i += producers) {
+                int value = i;
+                while (!queue.tryPush(move(value))) {
+                    this_thread::yield();
+                }
+            }
+        }));
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.push_back(thread([&queue, &consumed, items] {
+            int value;
+            while (consumed.load(memory_order_relaxed) < items) {
+                if (queue.tryPop(value)) {
+                    consumed++;
+                }
+                else {
+                    this_thread::yield();
+                }
+            }
+        }));
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+    return items / (omp_get_wtime() - start_time) / 1e6;
+}
+
+// Function to measure request intake under contention: the lock-free MpmcQueue against a mutex-protected
+// deque for every producer x consumer mix, written to output/queue_contention.csv, then ResizeEngine fed
+// small thumbnail jobs by several client threads through trySubmit, counting back-pressure refusals
+void queue_processImage(const char* inputFileName) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int width, height, channels;
+    unsigned char* img = loadImage(inputFileName, width, height, channels);
+    if (!img) {
+        return;
+    }
+
+    const int threadCounts[] = { 1, 2, 4, 8 };
+    const int items = 400000;
+    ofstream csv("output/queue_contention.csv");
+    csv << "# host logicalCpus=" << thread::hardware_concurrency() << endl << "producers,consumers,lockedMops,lockFreeMops,speedup" << endl;
+
+    cout << fixed << setprecision(3);
+    cout << "Queue throughput, " << items << " items through 1024 slots (Mops/s)" << endl;
+    for (int producers : threadCounts) {
+        for (int consumers : threadCounts) {
+            double locked = queueThroughput<LockedQueue<int>>(producers, consumers, items);
+            double lockFree = queueThroughput<MpmcQueue<int>>(producers, consumers, items);
+            csv << producers << "," << consumers << "," << locked << "," << lockFree << "," << lockFree / locked << endl;
+            cout << "  " << producers << "P x " << consumers << "C: mutex " << locked << ", lock-free " << lockFree
+                << ". Speedup: " << lockFree / locked << endl;
+        }
+    }
+
+    // every client submits its share of 64x64 thumbnails, retrying whenever the engine pushes back
+    const int jobsPerClient = 2000;
+    const int thumbnail = 64;
+    const size_t queueCapacity = 64;
+    int workers = max(1, omp_get_max_threads() - 1);
+
+    // a client has at most a full queue plus one job per worker in flight, so a
+    // ring of that many output slots lets every job write its own buffer
+    const size_t ringSlots = queueCapacity + workers;
+    const size_t thumbnailBytes = (size_t)thumbnail * thumbnail * channels;
+    for (int clients : { 1, 2, 4 }) {
+        vector<unsigned char> outputs(clients * ringSlots * thumbnailBytes);
+        vector<atomic<bool>> slotBusy(clients * ringSlots);
+        atomic<int> completed(0);
+        atomic<long long> refused(0);
+
+        double start_time = omp_get_wtime();
+        {
+            ResizeEngine engine(serial_ResizeBicubic, workers, queueCapacity);
+            vector<thread> threads;
+            for (int c = 0; c < clients; ++c) {
+                threads.push_back(thread([&, c] {
+                    for (int i = 0; i < jobsPerClient; ++i) {
+                        size_t slot = c * ringSlots + i % ringSlots;
+                        while (slotBusy[slot].load(memory_order_acquire)) {
+                            this_thread::yield();
+                        }
+                        slotBusy[slot].store(true, memory_order_relaxed);
+
+                        ResizeJob job = { img, width, height, channels, &outputs[slot * thumbnailBytes], thumbnail, thumbnail };
+                        auto release = [&completed, &slotBusy, slot](ResizeResult) {
+                            completed++;
+                            slotBusy[slot].store(false, memory_order_release);
+                        };
+                        while (!engine.trySubmit(job, release)) {
+                            refused++;
+                            this_thread::yield();
+                        }
+                    }
+                }));
+            }
+            for (thread& t : threads) {
+                t.join();
+            }
+        }
+        double run_time = omp_get_wtime() - start_time;
+
+        cout << "ResizeEngine, " << clients << " client(s) x " << jobsPerClient << " jobs on " << workers << " worker(s): "
+            << completed.load() / run_time << " jobs/s, " << refused.load() << " refused submits" << endl;
+    }
+
+    cout << endl << "Contention data written to output/queue_contention.csv" << endl;
+    stbi_image_free(img);
+}
+
+// Function to measure allocation churn of the experiment loop (trials x methods x widths) with
+// per-call allocation and with the BufferArena, without and with huge pages. The source is
+// loaded once so file I/O stays out of the counts; outputs are borrowed just as resizeImage does.
+void arena_processImage(const char* inputFileName, int w[]) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int width, height, channels;
+    unsigned char* img = loadImage(inputFileName, width, height, channels);
+    if (!img) {
+        return;
+    }
+    double aspectRatio = static_cast<double>(height) / static_cast<double>(width);
+
+    // the four fast backends; the separable ones also borrow their intermediate
+    const ResizeFunc methods[] = { openMP_ResizeBicubic, separable_ResizeBicubic, simd_ResizeBicubic, fixedPoint_ResizeBicubic };
+    const int numTrials = 5;
+
+    struct ArenaSetting {
+        const char* name;
+        bool enabled;
+        bool hugePages;
+    };
+    const ArenaSetting settings[] = { { "no arena", false, false }, { "arena", true, false }, { "arena + huge pages", true, true } };
+
+    BufferArena& arena = BufferArena::instance();
+    cout << fixed << setprecision(4);
+    for (const ArenaSetting& setting : settings) {
+        arena.setEnabled(setting.enabled);
+        arena.setHugePages(setting.hugePages);
+        arena.resetStats();
+        long long faultsBefore = processPageFaults();
+        int calls = 0;
+
+        double start_time = omp_get_wtime();
+        for (int i = 0; i < 5 && w[i] != 0; ++i) {
+            int newHeight = static_cast<int>(w[i] * aspectRatio);
+            for (int trial = 0; trial < numTrials; ++trial) {
+                for (ResizeFunc method : methods) {
+                    ArenaBuffer<unsigned char> resized((size_t)w[i] * newHeight * channels);
+                    method(img, width, height, channels, resized.data(), w[i], newHeight);
+                    ++calls;
+                }
+            }
+        }
+        double run_time = omp_get_wtime() - start_time;
+
+        ArenaStats stats = arena.stats();
+        long long faults = processPageFaults() - faultsBefore;
+        cout << setting.name << ": " << calls << " resizes in " << run_time << " seconds. System allocations: "
+            << stats.systemAllocations << ", reused: " << stats.reuses << ", page faults: " << faults
+            << " (" << (double)faults / calls << " per resize)" << endl;
+    }
+
+    arena.setEnabled(true);
+    arena.setHugePages(false);
+    stbi_image_free(img);
+}
+
+// Function to compare crop-then-resize through a packed copy of the crop against
+// resizing the crop's view in place, and to build a 2x2 contact sheet by writing
+// each quadrant's resize straight into its region of the canvas
+void region_processImage(const char* inputFileName) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int width, height, channels;
+    unsigned char* img = loadImage(inputFileName, width, height, channels);
+    if (!img) {
+        return;
+    }
+    ImageView source(img, width, height, channels);
+
+    struct RegionMethod {
+        const char* name;
+        ViewResizeFunc resize;
+    };
+    const RegionMethod methods[] = {
+        { "openMP", openMP_ResizeBicubic },
+        { "separable", separable_ResizeBicubic },
+        { "simd", simd_ResizeBicubic },
+        { "fixedPoint", fixedPoint_ResizeBicubic },
+    };
+    const int numTrials = 5;
+
+    // centre crop of half the width and height, upscaled 2x
+    ImageView crop = source.region(width / 4, height / 4, width / 2, height / 2);
+    int dstWidth = crop.width * 2, dstHeight = crop.height * 2;
+    cout << "Crop " << crop.width << "x" << crop.height << " at (" << width / 4 << ", " << height / 4
+        << ") -> " << dstWidth << "x" << dstHeight << endl;
+
+    vector<unsigned char> packedCrop((size_t)crop.width * crop.height * channels);
+    vector<unsigned char> copied((size_t)dstWidth * dstHeight * channels);
+    vector<unsigned char> inPlace(copied.size());
+
+    cout << fixed << setprecision(4);
+    for (const RegionMethod& method : methods) {
+        double copyTime = 0.0, viewTime = 0.0;
+        for (int trial = 0; trial < numTrials; ++trial) {
+            double start_time = omp_get_wtime();
+            for (int y = 0; y < crop.height; ++y) {
+                memcpy(&packedCrop[(size_t)y * crop.width * channels], crop.row(y), (size_t)crop.width * channels);
+            }
+            method.resize(ImageView(packedCrop.data(), crop.width, crop.height, channels),
+                ImageView(copied.data(), dstWidth, dstHeight, channels));
+            copyTime += omp_get_wtime() - start_time;
+
+            start_time = omp_get_wtime();
+            method.resize(crop, ImageView(inPlace.data(), dstWidth, dstHeight, channels));
+            viewTime += omp_get_wtime() - start_time;
+        }
+        cout << method.name << ": copy + resize " << copyTime / numTrials << " s, region view " << viewTime / numTrials
+            << " s (" << (copied == inPlace ? "identical" : "DIFFERENT") << ")" << endl;
+    }
+
+    // contact sheet: each quadrant resized straight into its cell of the canvas
+    int cellWidth = width / 2, cellHeight = height / 2;
+    vector<unsigned char> sheet((size_t)width * height * channels, 0);
+    ImageView canvas(sheet.data(), width, height, channels);
+    vector<unsigned char> expected((size_t)cellWidth * cellHeight * channels);
+    bool sheetMatches = true;
+
+    double start_time = omp_get_wtime();
+    for (int q = 0; q < 4; ++q) {
+        ImageView quadrant = source.region((q % 2) * cellWidth, (q / 2) * cellHeight, cellWidth, cellHeight);
+        separable_AntialiasResize<CatmullRomKernel>(quadrant,
+            canvas.region((q % 2) * cellWidth, (q / 2) * cellHeight, cellWidth, cellHeight));
+    }
+    double sheetTime = omp_get_wtime() - start_time;
+
+    for (int q = 0; q < 4 && sheetMatches; ++q) {
+        ImageView quadrant = source.region((q % 2) * cellWidth, (q / 2) * cellHeight, cellWidth, cellHeight);
+        ImageView cell(expected.data(), cellWidth, cellHeight, channels);
+        separable_AntialiasResize<CatmullRomKernel>(quadrant, cell);
+
+        ImageView written = canvas.region((q % 2) * cellWidth, (q / 2) * cellHeight, cellWidth, cellHeight);
+        for (int y = 0; y < cell.height && sheetMatches; ++y) {
+            sheetMatches = memcmp(cell.row(y), written.row(y), (size_t)cell.width * channels) == 0;
+        }
+    }
+    cout << "Contact sheet: " << sheetTime << " s, cells match packed resizes: " << (sheetMatches ? "yes" : "NO") << endl;
+
+    string output = generateOutputFileName(inputFileName, "sheet", width);
+    string outputSheet = "output/" + output.substr(5, output.length());
+    saveImage(outputSheet.c_str(), canvas);
+    output = generateOutputFileName(inputFileName, "crop", dstWidth);
+    string outputCrop = "output/" + output.substr(5, output.length());
+    saveImage(outputCrop.c_str(), ImageView(inPlace.data(), dstWidth, dstHeight, channels));
+
+    stbi_image_free(img);
+}
+
+// Largest difference between the output's corner blocks and the per-pixel 2D
+// filter; a wrapped 32-bit index shows up as garbage in the bottom rows
+static int cornerCheck(const ResizePlan& plan, const unsigned char* src, int channels, const unsigned char* dst) {
+    const int block = 8;
+    const int corners[][2] = { { 0, 0 }, { plan.dstWidth - block, 0 }, { 0, plan.dstHeight - block }, { plan.dstWidth - block, plan.dstHeight - block } };
+    vector<unsigned char> pixel(channels);
+    int maxDiff = 0;
+
+    for (const auto& corner : corners) {
+        for (int y = max(corner[1], 0); y < min(corner[1] + block, plan.dstHeight); ++y) {
+            for (int x = max(corner[0], 0); x < min(corner[0] + block, plan.dstWidth); ++x) {
+                bicubicPixel2D<0, unsigned char>(plan, src, (size_t)plan.srcWidth * channels, channels, pixel.data(), x, y);
+                const unsigned char* actual = &dst[((size_t)y * plan.dstWidth + x) * channels];
+                for (int c = 0; c < channels; ++c) {
+                    maxDiff = max(maxDiff, abs((int)pixel[c] - (int)actual[c]));
+                }
+            }
+        }
+    }
+    return maxDiff;
+}
+
+// Function to benchmark upscales whose outputs pass 2^31 bytes. The fast backends are timed in
+// memory against the separable output; PNG cannot hold such images, so only a centre crop of each
+// output is saved, through a view. Needs about twice the output size in RAM. Rows go to
+// output/gigapixel.csv.
+void gigapixel_processImage(const char* inputFileName, const int w[], int count) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int width, height, channels;
+    unsigned char* img = loadImage(inputFileName, width, height, channels);
+    if (!img) {
+        return;
+    }
+    double aspectRatio = static_cast<double>(height) / static_cast<double>(width);
+
+    struct GigapixelMethod {
+        const char* name;
+        ViewResizeFunc resize;
+    };
+    const GigapixelMethod methods[] = {
+        { "openMP", openMP_ResizeBicubic },
+        { "simd", simd_ResizeBicubic },
+        { "fixedPoint", fixedPoint_ResizeBicubic },
+        { "stream", stream_ResizeBicubic },
+    };
+
+    ofstream csv("output/gigapixel.csv");
+    csv << "width,height,gigabytes,method,seconds,mpixPerSecond,mseVsSeparable" << endl;
+    cout << fixed << setprecision(4);
+
+    for (int i = 0; i < count; ++i) {
+        int newWidth = w[i];
+        int newHeight = static_cast<int>(newWidth * aspectRatio);
+        size_t dstBytes = (size_t)newWidth * newHeight * channels;
+        double megapixels = static_cast<double>(newWidth) * newHeight / 1e6;
+        const ResizePlan& plan = *getResizePlan(width, height, newWidth, newHeight);
+
+        cout << endl << "Width: " << newWidth << " (" << newWidth << "x" << newHeight << "x" << channels << ", "
+            << dstBytes / 1e9 << " GB" << (dstBytes > (size_t)INT_MAX ? ", past 2^31 bytes" : "") << ")" << endl;
+
+        ArenaBuffer<unsigned char> reference(dstBytes);
+        ImageView referenceView(reference.data(), newWidth, newHeight, channels);
+        double start_time = omp_get_wtime();
+        separable_ResizeBicubic(plan, ImageView(img, width, height, channels), referenceView);
+        double separableTime = omp_get_wtime() - start_time;
+
+        int cornerDiff = cornerCheck(plan, img, channels, reference.data());
+        cout << "separable: " << separableTime << " seconds. " << megapixels / separableTime << " MPix/s"
+            << " (corner blocks vs per-pixel filter: max difference " << cornerDiff << ")" << endl;
+        csv << newWidth << "," << newHeight << "," << dstBytes / 1e9 << ",separable," << separableTime << ","
+            << megapixels / separableTime << ",0" << endl;
+
+        ArenaBuffer<unsigned char> resized(dstBytes);
+        for (const GigapixelMethod& method : methods) {
+            start_time = omp_get_wtime();
+            method.resize(ImageView(img, width, height, channels), ImageView(resized.data(), newWidth, newHeight, channels));
+            double run_time = omp_get_wtime() - start_time;
+
+            double mse = calculateMSE(reference.data(), resized.data(), newWidth, newHeight, channels);
+            cout << method.name << ": " << run_time << " seconds. " << megapixels / run_time << " MPix/s (MSE vs separable: "
+                << mse << ")" << endl;
+            csv << newWidth << "," << newHeight << "," << dstBytes / 1e9 << "," << method.name << "," << run_time << ","
+                << megapixels / run_time << "," << mse << endl;
+        }
+
+        // a 2000x2000 window from the middle of the image, written straight from the big buffer
+        ImageView preview = referenceView.region(newWidth / 2 - 1000, newHeight / 2 - 1000, 2000, 2000);
+        string output = generateOutputFileName(inputFileName, "gigapixel_crop", newWidth);
+        saveImage(("output/" + output.substr(5, output.length())).c_str(), preview);
+    }
+
+    cout << endl << "Gigapixel data written to output/gigapixel.csv" << endl;
+    stbi_image_free(img);
+}
+
+// Function to resize images bigger than RAM between memory-mapped tiled files. A small run
+// first checks the out-of-core output against openMP in memory; then the input is streamed
+// up to a 24000 wide tiled source, which is resized to each width under memoryBudget.
+// The tiled files are scratch and removed afterwards; a centre crop of each output is saved.
+void outOfCore_processImage(const char* inputFileName, int w[], size_t memoryBudget) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int width, height, channels;
+    unsigned char* img = loadImage(inputFileName, width, height, channels);
+    if (!img) {
+        return;
+    }
+    double aspectRatio = static_cast<double>(height) / static_cast<double>(width);
+    OutOfCoreOptions options;
+    options.memoryBudget = memoryBudget;
+    cout << fixed << setprecision(4);
+
+    // small tiles so the check crosses many tile edges
+    const string checkSource = "output/outOfCore_check_src.tiled", checkOutput = "output/outOfCore_check_dst.tiled";
+    int checkWidth = width * 2, checkHeight = height * 2;
+    bool matches = tiled_WriteImage(checkSource, ImageView(img, width, height, channels), 64, 64)
+        && outOfCore_ResizeBicubic(checkSource, checkOutput, checkWidth, checkHeight, options);
+    if (matches) {
+        vector<unsigned char> expected((size_t)checkWidth * checkHeight * channels), actual(expected.size());
+        openMP_ResizeBicubic(img, width, height, channels, expected.data(), checkWidth, checkHeight);
+        TiledImage checked;
+        matches = checked.open(checkOutput);
+        if (matches) {
+            checked.readRegion(0, 0, ImageView(actual.data(), checkWidth, checkHeight, channels));
+            matches = expected == actual;
+        }
+    }
+    remove(checkSource.c_str());
+    remove(checkOutput.c_str());
+    cout << "Out-of-core " << width << "x" << height << " -> " << checkWidth << "x" << checkHeight << " in 64x64 tiles "
+        << (matches ? "matches" : "DOES NOT match") << " openMP in memory" << endl;
+
+    // the source is written one tile row at a time, so it never sits in memory either
+    const string source = "output/outOfCore_src.tiled";
+    int srcWidth = 24000, srcHeight = static_cast<int>(srcWidth * aspectRatio);
+    TiledImage tiled;
+    if (!tiled.create(source, srcWidth, srcHeight, channels)) {
+        cerr << "Failed to create tiled image: " << source << endl;
+        stbi_image_free(img);
+        return;
+    }
+    size_t srcStride = (size_t)width * channels;
+    double start_time = omp_get_wtime();
+    bool ok = stream_ResizeBicubic(width, height, channels, srcWidth, srcHeight,
+        [&](int y, unsigned char* row) {
+            memcpy(row, &img[y * srcStride], srcStride);
+            return true;
+        },
+        [&](int y, const unsigned char* row) {
+            tiled.writeRegion(0, y, ImageView(const_cast<unsigned char*>(row), srcWidth, 1, channels));
+            if ((y + 1) % tiled.tileHeight() == 0 || y + 1 == srcHeight) {
+                tiled.releaseTiles(0, y / tiled.tileHeight(), tiled.tilesX(), y / tiled.tileHeight() + 1);
+            }
+            return true;
+        });
+    ok = ok && tiled.flush();
+    cout << "Tiled source " << srcWidth << "x" << srcHeight << "x" << channels << " (" << (double)tiled.fileBytes() / 1e9
+        << " GB) written in " << omp_get_wtime() - start_time << " seconds" << (ok ? "" : " (failed)") << endl;
+    tiled.close();
+
+    for (int i = 0; ok && i < 5 && w[i] != 0; ++i) {
+        int newWidth = w[i];
+        int newHeight = static_cast<int>(newWidth * aspectRatio);
+        string output = "output/outOfCore_" + to_string(newWidth) + ".tiled";
+
+        OutOfCoreStats stats;
+        if (!outOfCore_ResizeBicubic(source, output, newWidth, newHeight, options, &stats)) {
+            break;
+        }
+        double megapixels = static_cast<double>(newWidth) * newHeight / 1e6;
+        cout << endl << "Width: " << newWidth << " (" << newWidth << "x" << newHeight << "x" << channels << ", "
+            << megapixels * channels / 1e3 << " GB)" << endl;
+        cout << "Time: " << stats.seconds << " seconds. " << megapixels / stats.seconds << " MPix/s, waiting on prefetch "
+            << stats.prefetchWaitSeconds << " seconds" << endl;
+        cout << "Blocks: " << stats.blocks << ", source tiles fetched: " << stats.sourceTileFetches << " of "
+            << stats.sourceTiles << endl;
+        cout << "Budget: " << memoryBudget / (1024.0 * 1024.0) << " MB, planned peak: " << stats.plannedPeakBytes / (1024.0 * 1024.0)
+            << " MB" << (stats.overBudget ? " (one tile row does not fit, budget exceeded)" : "") << ", process peak RSS: "
+            << processPeakResidentBytes() / (1024.0 * 1024.0) << " MB" << endl;
+
+        TiledImage result;
+        if (result.open(output)) {
+            int cropWidth = min(2000, newWidth), cropHeight = min(2000, newHeight);
+            vector<unsigned char> crop((size_t)cropWidth * cropHeight * channels);
+            result.readRegion((newWidth - cropWidth) / 2, (newHeight - cropHeight) / 2, ImageView(crop.data(), cropWidth, cropHeight, channels));
+            string previewName = generateOutputFileName(inputFileName, "outOfCore_crop", newWidth);
+            saveImage(("output/" + previewName.substr(5, previewName.length())).c_str(), ImageView(crop.data(), cropWidth, cropHeight, channels));
+        }
+        result.close();
+        remove(output.c_str());
+    }
+
+    remove(source.c_str());
+    stbi_image_free(img);
+}
+
+// Function to compare the decode path (stbi_load into a fresh buffer, resize, write the file) with
+// memory-mapped I/O, where the resize reads the mapped source in place and writes into a mapped
+// destination. The input is first written as a mapped PNM/PAM and as raw; a ResizeEngine run then
+// hands every width's job mapped buffers directly. Rows go to output/mapped.csv.
+void mapped_processImage(const char* inputFileName, int w[]) {
+    cout << endl << "------------------------------------------------------------------------" << endl;
+
+    int width, height, channels;
+    unsigned char* img = loadImage(inputFileName, width, height, channels);
+    if (!img) {
+        return;
+    }
+    double aspectRatio = static_cast<double>(height) / static_cast<double>(width);
+    size_t imageBytes = (size_t)width * height * channels;
+
+    // PPM and PGM hold only RGB and gray; stbi_load reads both back, but not PAM
+    const char* extension = channels == 3 ? ".ppm" : channels == 1 ? ".pgm" : ".pam";
+    const string inputs[] = { string("output/mapped_input") + extension, "output/mapped_input.raw" };
+    for (const string& input : inputs) {
+        MappedImage mapped;
+        if (!mapped.create(input, width, height, channels)) {
+            stbi_image_free(img);
+            return;
+        }
+        memcpy(mapped.view().data, img, imageBytes);
+        mapped.close();
+
+        bool roundTrip = mapped.open(input) && memcmp(mapped.view().data, img, imageBytes) == 0;
+        cout << "Wrote " << input << (roundTrip ? " (reads back identical)" : " (DOES NOT read back identical)") << endl;
+    }
+
+    ofstream csv("output/mapped.csv");
+    csv << "width,height,path,totalSeconds,resizeSeconds,ioSeconds,mse" << endl;
+    cout << fixed << setprecision(4);
+
+    for (int i = 0; i < 5 && w[i] != 0; ++i) {
+        int newWidth = w[i];
+        int newHeight = static_cast<int>(newWidth * aspectRatio);
+        size_t dstBytes = (size_t)newWidth * newHeight * channels;
+        cout << endl << "Width: " << newWidth << " (" << newWidth << "x" << newHeight << ")" << endl;
+
+        // decode into a new buffer, resize, then write the same format with a stream
+        string decodedOutput = "output/mapped_decoded_" + to_string(newWidth) + extension;
+        double start_time = omp_get_wtime();
+        int srcWidth, srcHeight, srcChannels;
+        unsigned char* decoded = channels == 2 || channels == 4 ? nullptr : loadImage(inputs[0].c_str(), srcWidth, srcHeight, srcChannels);
+        vector<unsigned char> reference(dstBytes);
+        double resizeTime = 0.0;
+        if (decoded) {
+            double resize_start = omp_get_wtime();
+            openMP_ResizeBicubic(decoded, width, height, channels, reference.data(), newWidth, newHeight);
+            resizeTime = omp_get_wtime() - resize_start;
+            ofstream file(decodedOutput, ios::binary);
+            file << (channels == 3 ? "P6" : "P5") << "\n" << newWidth << " " << newHeight << "\n255\n";
+            file.write((const char*)reference.data(), dstBytes);
+            stbi_image_free(decoded);
+        }
+        else {
+            // no stb reader for PAM; the reference still comes from the decoded original
+            openMP_ResizeBicubic(img, width, height, channels, reference.data(), newWidth, newHeight);
+        }
+        double decodedTime = omp_get_wtime() - start_time;
+        if (decoded) {
+            cout << "decode + write: " << decodedTime << " seconds (resize " << resizeTime << ", I/O " << decodedTime - resizeTime << ")" << endl;
+            csv << newWidth << "," << newHeight << ",decode," << decodedTime << "," << resizeTime << "," << decodedTime - resizeTime << ",0" << endl;
+        }
+
+        for (const string& input : inputs) {
+            string output = "output/mapped_" + to_string(newWidth) + input.substr(input.find_last_of('.'));
+            start_time = omp_get_wtime();
+            double mappedResize = mapped_resizeImage(openMP_ResizeBicubic, input.c_str(), output.c_str(), newWidth, newHeight);
+            double mappedTime = omp_get_wtime() - start_time;
+            if (mappedResize < 0) {
+                continue;
+            }
+
+            MappedImage result;
+            double mse = result.open(output) ? calculateMSE(reference.data(), result.view().data, newWidth, newHeight, channels) : -1.0;
+            string path = "mapped " + input.substr(input.find_last_of('.') + 1);
+            cout << path << ": " << mappedTime << " seconds (resize " << mappedResize << ", I/O " << mappedTime - mappedResize
+                << ", MSE vs decode path: " << mse << ")" << endl;
+            csv << newWidth << "," << newHeight << "," << path << "," << mappedTime << "," << mappedResize << ","
+                << mappedTime - mappedResize << "," << mse << endl;
+        }
+    }
+
+    // every width through one engine, each job pointing straight at mapped files
+    MappedImage source;
+    if (source.open(inputs[1])) {
+        vector<MappedImage> outputs(5);
+        vector<future<ResizeResult>> results;
+        double start_time = omp_get_wtime();
+        {
+            ResizeEngine engine(openMP_ResizeBicubic, 1);
+            for (int i = 0; i < 5 && w[i] != 0; ++i) {
+                int newHeight = static_cast<int>(w[i] * aspectRatio);
+                if (!outputs[i].create("output/mapped_engine_" + to_string(w[i]) + ".raw", w[i], newHeight, channels)) {
+                    continue;
+                }
+                ResizeJob job = { source.view().data, width, height, channels, outputs[i].view().data, w[i], newHeight };
+                results.push_back(engine.submit(job));
+            }
+            for (future<ResizeResult>& result : results) {
+                result.get();
+            }
+        }
+        for (MappedImage& output : outputs) {
+            output.close();
+        }
+        cout << endl << "ResizeEngine over mapped raw files: " << results.size() << " widths in " << omp_get_wtime() - start_time
+            << " seconds" << endl;
+    }
+
+    cout << endl << "Mapped I/O data written to output/mapped.csv" << endl;
+    stbi_image_free(img);
+}
+
+// Checks every accelerated path against its reference; the number of checks that failed
+int selfTest_run() {
+    int failures = 0;
+
+    // Check the vectorized path picked for this CPU against the serial reference
+    SimdLevel simdLevel = simd_ActiveLevel();
+    int simdMaxDiff = simd_CheckAgainstSerial(simdLevel);
+    cout << "SIMD path: " << simdLevelName(simdLevel) << " (max difference vs serial: " << simdMaxDiff << ")" << endl;
+    if (simdMaxDiff > 1) {
+        cerr << "Warning: SIMD path exceeds the +-1 error bound against serial." << endl;
+        ++failures;
+    }
+
+    // Fixed-point rounds where serial truncates, so +-1 on about half the samples is expected
+    double fixedMismatched;
+    int fixedMaxDiff = fixedPoint_CheckAgainstSerial(simdLevel, fixedMismatched);
+    cout << "Fixed-point path: max difference vs serial: " << fixedMaxDiff
+        << ", samples differing: " << fixedMismatched * 100.0 << "%" << endl;
+    if (fixedMaxDiff > 1) {
+        cerr << "Warning: fixed-point path exceeds the +-1 error bound against serial." << endl;
+        ++failures;
+    }
+
+    // Antialiased downscales must average a checkerboard to gray where the plain plan aliases
+    int plainDeviation;
+    int antialiasDeviation = separable_CheckAntialias(plainDeviation);
+    cout << "Antialiased downscale: checkerboard max deviation from gray: " << antialiasDeviation
+        << " (plain plan: " << plainDeviation << ")" << endl;
+    if (antialiasDeviation > 4) {
+        cerr << "Warning: antialiased downscale aliases on the checkerboard." << endl;
+        ++failures;
+    }
+
+    // Whole-image and tiled batch tasks must both match the per-image OpenMP resize
+    BatchStrategy batchStrategy;
+    int batchMaxDiff = batch_CheckAgainstOpenMP(batchStrategy);
+    cout << "Batch path (" << batchStrategyName(batchStrategy) << " on 4 threads): max difference vs openMP: " << batchMaxDiff << endl;
+    if (batchMaxDiff != 0 || batchStrategy != BATCH_MIXED) {
+        cerr << "Warning: mixed batch does not match openMP." << endl;
+        ++failures;
+    }
+
+    // The row ring must reproduce separable bit for bit, every border mode included
+    int streamMaxDiff = stream_CheckAgainstSeparable();
+    cout << "Streaming path: max difference vs separable: " << streamMaxDiff << endl;
+    if (streamMaxDiff != 0) {
+        cerr << "Warning: streaming path does not match separable." << endl;
+        ++failures;
+    }
+
+    cout << (failures == 0 ? "All self-tests passed." : "Some self-tests failed.") << endl;
+    return failures;
+}
+
 int main() {
     string inputFileName;
     int mode;
@@ -246,10 +1710,59 @@ int main() {
     cout << "       Image Processing Application" << endl;
     cout << "------------------------------------------" << endl;
 
-    cout << "Enter the input image name: ";
+    cout << "Select mode (1: resize experiment, 2: large downscale benchmark, 3: small-image overhead benchmark, 4: batch benchmark, 5: streaming resize, 6: async resize + encode, 7: file batch with overlapped I/O, 8: auto-selected backend, 9: thread scaling benchmark, 10: NUMA placement benchmark, 11: job queue contention benchmark, 12: buffer arena benchmark, 13: region (zero-copy crop) resize, 14: gigapixel upscale benchmark, 15: out-of-core tiled resize, 16: memory-mapped image I/O, 17: self-test): ";
+    string modeInput;
+    getline(cin, modeInput);
+    mode = modeInput.empty() ? 1 : atoi(modeInput.c_str());
+
+    if (mode == 17) {
+        return selfTest_run() == 0 ? 0 : 1;
+    }
+
+    cout << (mode == 7 ? "Enter the input image names separated by commas: " : "Enter the input image name: ");
     getline(cin, inputFileName);
+
+    vector<string> inputFileNames;
+    std::stringstream names(inputFileName);
+    string name;
+    while (getline(names, name, ',')) {
+        inputFileNames.push_back("data/" + name);
+    }
     inputFileName = "data/" + inputFileName;
 
+    if (mode == 2) {
+        // 12000 -> 750 is the 16x reduction the pyramid is meant for
+        downscale_processImage(inputFileName.c_str(), 12000, 750);
+        return 0;
+    }
+    if (mode == 3) {
+        overhead_processImage(inputFileName.c_str());
+        return 0;
+    }
+    if (mode == 4) {
+        batch_processImage(inputFileName.c_str());
+        return 0;
+    }
+    if (mode == 11) {
+        queue_processImage(inputFileName.c_str());
+        return 0;
+    }
+    if (mode == 13) {
+        region_processImage(inputFileName.c_str());
+        return 0;
+    }
+    if (mode == 14) {
+        // 24000 and 48000 wide outputs pass 2^31 bytes, where 32-bit indices used to wrap
+        const int gigapixelWidths[] = { 24000, 48000 };
+        gigapixel_processImage(inputFileName.c_str(), gigapixelWidths, 2);
+        return 0;
+    }
+    if (mode == 5) {
+        // 12000 wide is the README's largest upscale
+        stream_processImage(inputFileName.c_str(), 12000);
+        return 0;
+    }
+
     int widths[] = {0,0,0,0,0};
     string input;
     int count = 0;
@@ -267,6 +1780,42 @@ int main() {
         ss >> comma;
     }
 
+    if (mode == 16) {
+        mapped_processImage(inputFileName.c_str(), widths);
+        return 0;
+    }
+    if (mode == 15) {
+        cout << "Enter the memory budget in MB (default 256): ";
+        getline(cin, input);
+        size_t budgetMB = input.empty() ? 256 : (size_t)atoi(input.c_str());
+        outOfCore_processImage(inputFileName.c_str(), widths, budgetMB << 20);
+        return 0;
+    }
+    if (mode == 12) {
+        arena_processImage(inputFileName.c_str(), widths);
+        return 0;
+    }
+    if (mode == 10) {
+        numa_processImage(inputFileName.c_str(), widths);
+        return 0;
+    }
+    if (mode == 9) {
+        scaling_processImage(inputFileName.c_str(), widths);
+        return 0;
+    }
+    if (mode == 8) {
+        auto_processImage(inputFileName.c_str(), widths);
+        return 0;
+    }
+    if (mode == 7) {
+        fileBatch_processImages(inputFileNames, widths);
+        return 0;
+    }
+    if (mode == 6) {
+        async_processImage(inputFileName.c_str(), widths);
+        return 0;
+    }
+
     experiment_processImage(inputFileName.c_str(), widths);
 
     return 0;
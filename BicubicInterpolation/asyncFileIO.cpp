@@ -0,0 +1,290 @@
+#include <iostream>
+#include <fstream>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "asyncFileIO.h"
+
+// io_uring is opt-in: define USE_LIBURING and link -luring
+#if defined(USE_LIBURING) && defined(__linux__)
+#define HAVE_LIBURING 1
+#include <liburing.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+using namespace std;
+
+// Fallback: blocking reads and writes on a small set of I/O threads
+class ThreadFileIO : public AsyncFileIO {
+public:
+    explicit ThreadFileIO(int threads) : stopping(false) {
+        for (int i = 0; i < threads; ++i) {
+            workers.push_back(thread(&ThreadFileIO::workerLoop, this));
+        }
+    }
+
+    ~ThreadFileIO() {
+        {
+            lock_guard<mutex> lock(queueMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    const char* backendName() const { return "I/O threads"; }
+
+    future<vector<unsigned char>> readFile(const string& path) {
+        shared_ptr<promise<vector<unsigned char>>> result = make_shared<promise<vector<unsigned char>>>();
+        post([path, result] {
+            vector<unsigned char> data;
+            ifstream file(path, ios::binary | ios::ate);
+            if (file) {
+                data.resize((size_t)file.tellg());
+                file.seekg(0);
+                if (!file.read((char*)data.data(), data.size())) {
+                    data.clear();
+                }
+            }
+            result->set_value(move(data));
+        });
+        return result->get_future();
+    }
+
+    future<bool> writeFile(const string& path, vector<unsigned char> data) {
+        shared_ptr<promise<bool>> result = make_shared<promise<bool>>();
+        shared_ptr<vector<unsigned char>> buffer = make_shared<vector<unsigned char>>(move(data));
+        post([path, buffer, result] {
+            ofstream file(path, ios::binary);
+            file.write((const char*)buffer->data(), buffer->size());
+            result->set_value((bool)file);
+        });
+        return result->get_future();
+    }
+
+private:
+    void post(function<void()> task) {
+        {
+            lock_guard<mutex> lock(queueMutex);
+            tasks.push_back(move(task));
+        }
+        wake.notify_one();
+    }
+
+    void workerLoop() {
+        while (true) {
+            function<void()> task;
+            {
+                unique_lock<mutex> lock(queueMutex);
+                wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) {
+                    return;
+                }
+                task = move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    deque<function<void()>> tasks;
+    mutex queueMutex;
+    condition_variable wake;
+    bool stopping;
+    vector<thread> workers;
+};
+
+#ifdef HAVE_LIBURING
+
+// One ring shared by all requests. Submitters fill SQEs under a mutex; a
+// completion thread reaps CQEs, resubmits short transfers and settles the
+// promises. Each request reads or writes a whole file in one go.
+class UringFileIO : public AsyncFileIO {
+public:
+    UringFileIO() : ready(false), inFlight(0), stopping(false) {}
+
+    bool init(int queueDepth) {
+        if (io_uring_queue_init(queueDepth, &ring, 0) < 0) {
+            return false;
+        }
+        ready = true;
+        reaper = thread(&UringFileIO::reapLoop, this);
+        return true;
+    }
+
+    ~UringFileIO() {
+        if (!ready) {
+            return;
+        }
+        {
+            unique_lock<mutex> lock(submitMutex);
+            drained.wait(lock, [this] { return inFlight == 0; });
+            stopping = true;
+
+            // wake the reaper with a no-op
+            io_uring_sqe* sqe = io_uring_get_sqe(&ring);
+            io_uring_prep_nop(sqe);
+            io_uring_sqe_set_data(sqe, nullptr);
+            io_uring_submit(&ring);
+        }
+        reaper.join();
+        io_uring_queue_exit(&ring);
+    }
+
+    const char* backendName() const { return "io_uring"; }
+
+    future<vector<unsigned char>> readFile(const string& path) {
+        Request* request = new Request();
+        request->writing = false;
+        future<vector<unsigned char>> done = request->readResult.get_future();
+
+        request->fd = open(path.c_str(), O_RDONLY);
+        struct stat info;
+        if (request->fd < 0 || fstat(request->fd, &info) < 0) {
+            finish(request, false);
+            return done;
+        }
+        request->data.resize((size_t)info.st_size);
+        if (request->data.empty()) {
+            finish(request, true);
+            return done;
+        }
+        submit(request);
+        return done;
+    }
+
+    future<bool> writeFile(const string& path, vector<unsigned char> data) {
+        Request* request = new Request();
+        request->writing = true;
+        request->data = move(data);
+        future<bool> done = request->writeResult.get_future();
+
+        request->fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (request->fd < 0) {
+            finish(request, false);
+            return done;
+        }
+        if (request->data.empty()) {
+            finish(request, true);
+            return done;
+        }
+        submit(request);
+        return done;
+    }
+
+private:
+    struct Request {
+        bool writing;
+        int fd = -1;
+        size_t offset = 0;
+        vector<unsigned char> data;
+        promise<vector<unsigned char>> readResult;
+        promise<bool> writeResult;
+    };
+
+    // queues the remaining part of the transfer; called with or without submitMutex
+    void submit(Request* request, bool locked = false) {
+        unique_lock<mutex> lock(submitMutex, defer_lock);
+        if (!locked) {
+            lock.lock();
+            ++inFlight;
+        }
+
+        io_uring_sqe* sqe;
+        while ((sqe = io_uring_get_sqe(&ring)) == nullptr) {
+            io_uring_submit(&ring);
+        }
+        size_t remaining = request->data.size() - request->offset;
+        unsigned int length = (unsigned int)min<size_t>(remaining, 1u << 30);
+        if (request->writing) {
+            io_uring_prep_write(sqe, request->fd, request->data.data() + request->offset, length, request->offset);
+        }
+        else {
+            io_uring_prep_read(sqe, request->fd, request->data.data() + request->offset, length, request->offset);
+        }
+        io_uring_sqe_set_data(sqe, request);
+        io_uring_submit(&ring);
+    }
+
+    void finish(Request* request, bool ok) {
+        if (request->fd >= 0) {
+            close(request->fd);
+        }
+        if (request->writing) {
+            request->writeResult.set_value(ok);
+        }
+        else {
+            if (!ok) {
+                request->data.clear();
+            }
+            request->readResult.set_value(move(request->data));
+        }
+        delete request;
+    }
+
+    void reapLoop() {
+        while (true) {
+            io_uring_cqe* cqe;
+            if (io_uring_wait_cqe(&ring, &cqe) < 0) {
+                continue;
+            }
+            Request* request = (Request*)io_uring_cqe_get_data(cqe);
+            int transferred = cqe->res;
+            io_uring_cqe_seen(&ring, cqe);
+
+            if (request == nullptr) {
+                if (stopping) {
+                    return;
+                }
+                continue;
+            }
+
+            if (transferred > 0) {
+                request->offset += transferred;
+                if (request->offset < request->data.size()) {
+                    lock_guard<mutex> lock(submitMutex);
+                    submit(request, true);
+                    continue;
+                }
+            }
+
+            // 0 before the end (file shrank) or a negative errno is a failure
+            finish(request, request->offset == request->data.size());
+            {
+                lock_guard<mutex> lock(submitMutex);
+                --inFlight;
+            }
+            drained.notify_all();
+        }
+    }
+
+    io_uring ring;
+    bool ready;
+    thread reaper;
+    mutex submitMutex;
+    condition_variable drained;
+    int inFlight;
+    atomic<bool> stopping;
+};
+
+#endif
+
+unique_ptr<AsyncFileIO> AsyncFileIO::create(int queueDepth, int threads) {
+#ifdef HAVE_LIBURING
+    // the kernel may still refuse a ring (too old, seccomp, io_uring disabled)
+    unique_ptr<UringFileIO> uring(new UringFileIO());
+    if (uring->init(queueDepth)) {
+        return unique_ptr<AsyncFileIO>(uring.release());
+    }
+#else
+    (void)queueDepth;
+#endif
+    return unique_ptr<AsyncFileIO>(new ThreadFileIO(threads));
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Whole-file reads and writes that complete in the background, so the batch
+// driver can fetch the next input and flush the previous output while the
+// current image is resized. Built with USE_LIBURING on Linux (link -luring)
+// requests go through io_uring; otherwise, or if the kernel refuses a ring,
+// a couple of I/O threads do plain blocking reads and writes.
+class AsyncFileIO {
+public:
+    virtual ~AsyncFileIO() {}
+
+    // An io_uring of queueDepth entries when built for it and the kernel
+    // allows one, otherwise threads I/O threads each running one request at a time
+    static std::unique_ptr<AsyncFileIO> create(int queueDepth = 16, int threads = 2);
+
+    virtual const char* backendName() const = 0;
+
+    // Empty vector if the file cannot be opened or read
+    virtual std::future<std::vector<unsigned char>> readFile(const std::string& path) = 0;
+
+    // The buffer is owned by the request until the future is ready
+    virtual std::future<bool> writeFile(const std::string& path, std::vector<unsigned char> data) = 0;
+};
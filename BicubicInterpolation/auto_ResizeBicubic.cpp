@@ -0,0 +1,235 @@
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+#include <omp.h>
+#include "auto_ResizeBicubic.h"
+#include "serial_ResizeBicubic.h"
+#include "openMP_ResizeBicubic.h"
+#include "simd_ResizeBicubic.h"
+#include "cuda_ResizeBicubic.cuh"
+
+using namespace std;
+
+static void runChoice(const ResizeChoice& choice, const ImageView& src, const ImageView& dst) {
+    // the thread count is a per-thread ICV, so setting it here does not leak to other callers
+    int previousThreads = omp_get_max_threads();
+    omp_set_num_threads(choice.threads);
+
+    switch (choice.backend) {
+    case BACKEND_OPENMP:
+        openMP_ResizeBicubic(*getResizePlan(src.width, src.height, dst.width, dst.height), src, dst, choice.tileWidth, choice.tileHeight);
+        break;
+    case BACKEND_SIMD:
+        simd_ResizeBicubic(src, dst);
+        break;
+    case BACKEND_CUDA:
+        cuda_ResizeBicubic(src, dst);
+        break;
+    default:
+        serial_ResizeBicubic(src, dst);
+        break;
+    }
+
+    omp_set_num_threads(previousThreads);
+}
+
+static vector<ResizeChoice> calibrationCandidates(int maxThreads) {
+    vector<ResizeChoice> candidates;
+    candidates.push_back(ResizeChoice{ BACKEND_SERIAL, 1, 0, 0 });
+
+    vector<int> threadCounts = { maxThreads };
+    if (maxThreads >= 4) {
+        threadCounts.push_back(maxThreads / 2);
+    }
+    for (int threads : threadCounts) {
+        candidates.push_back(ResizeChoice{ BACKEND_OPENMP, threads, 0, 0 });
+        candidates.push_back(ResizeChoice{ BACKEND_OPENMP, threads, 64, 64 });
+        candidates.push_back(ResizeChoice{ BACKEND_SIMD, threads, 0, 0 });
+    }
+    // without a device cuda_ResizeBicubic would exit the process on its first call
+    if (cuda_DeviceAvailable()) {
+        candidates.push_back(ResizeChoice{ BACKEND_CUDA, 1, 0, 0 });
+    }
+    return candidates;
+}
+
+vector<CalibrationEntry> auto_Calibrate(const char* path) {
+    const int maxThreads = omp_get_max_threads();
+    const int channelCounts[] = { 1, 3, 4 };
+    const int outputWidths[] = { 64, 256, 750, 1500 };
+    vector<ResizeChoice> candidates = calibrationCandidates(maxThreads);
+    vector<CalibrationEntry> entries;
+
+    for (int channels : channelCounts) {
+        for (int dstWidth : outputWidths) {
+            // a 2x upscale of a 4:3 image, the README's typical case
+            int dstHeight = dstWidth * 3 / 4;
+            int srcWidth = dstWidth / 2, srcHeight = dstHeight / 2;
+
+            vector<unsigned char> src((size_t)srcWidth * srcHeight * channels);
+            for (size_t i = 0; i < src.size(); ++i) {
+                src[i] = (unsigned char)((i * 2654435761u) >> 24);
+            }
+            vector<unsigned char> reference((size_t)dstWidth * dstHeight * channels);
+            vector<unsigned char> dst(reference.size());
+            serial_ResizeBicubic(src.data(), srcWidth, srcHeight, channels, reference.data(), dstWidth, dstHeight);
+
+            // more repeats for the small sizes, where timer noise dominates
+            int repeats = dstWidth <= 256 ? 20 : 3;
+            ImageView srcView(src.data(), srcWidth, srcHeight, channels);
+            ImageView dstView(dst.data(), dstWidth, dstHeight, channels);
+            CalibrationEntry best = { channels, (double)dstWidth * dstHeight, candidates[0], 1e30 };
+
+            for (const ResizeChoice& choice : candidates) {
+                // cleared first, so a backend that writes nothing cannot pass on the last one's output
+                fill(dst.begin(), dst.end(), (unsigned char)0);
+                runChoice(choice, srcView, dstView);
+
+                bool valid = true;
+                for (size_t i = 0; i < dst.size() && valid; ++i) {
+                    valid = abs((int)dst[i] - (int)reference[i]) <= 1;
+                }
+                if (!valid) {
+                    continue;
+                }
+
+                double fastest = 1e30;
+                for (int r = 0; r < repeats; ++r) {
+                    double start_time = omp_get_wtime();
+                    runChoice(choice, srcView, dstView);
+                    fastest = min(fastest, omp_get_wtime() - start_time);
+                }
+                if (fastest < best.seconds) {
+                    best.choice = choice;
+                    best.seconds = fastest;
+                }
+            }
+            entries.push_back(best);
+        }
+    }
+
+    if (path) {
+        ofstream file(path);
+        file << "# bicubic resize calibration: channels outputPixels backend threads tileWidth tileHeight seconds" << endl;
+        file << "host " << maxThreads << " " << simdLevelName(simd_ActiveLevel()) << endl;
+        for (const CalibrationEntry& entry : entries) {
+            file << entry.channels << " " << (long long)entry.outputPixels << " " << resizeBackendName(entry.choice.backend) << " "
+                << entry.choice.threads << " " << entry.choice.tileWidth << " " << entry.choice.tileHeight << " " << entry.seconds << endl;
+        }
+        if (!file) {
+            cerr << "Failed to save calibration: " << path << endl;
+        }
+    }
+    return entries;
+}
+
+bool auto_LoadCalibration(vector<CalibrationEntry>& entries, const char* path) {
+    ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    entries.clear();
+    bool hostMatches = false;
+    string line;
+    while (getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        istringstream fields(line);
+        if (line.compare(0, 5, "host ") == 0) {
+            string tag, simd;
+            int threads;
+            fields >> tag >> threads >> simd;
+            hostMatches = threads == omp_get_max_threads() && simd == simdLevelName(simd_ActiveLevel());
+            continue;
+        }
+
+        CalibrationEntry entry;
+        string backend;
+        long long pixels;
+        fields >> entry.channels >> pixels >> backend >> entry.choice.threads
+            >> entry.choice.tileWidth >> entry.choice.tileHeight >> entry.seconds;
+        if (!fields) {
+            return false;
+        }
+        entry.outputPixels = (double)pixels;
+        entry.choice.backend = BACKEND_SERIAL;
+        for (int b = BACKEND_SERIAL; b <= BACKEND_CUDA; ++b) {
+            if (backend == resizeBackendName((ResizeBackend)b)) {
+                entry.choice.backend = (ResizeBackend)b;
+            }
+        }
+        // a file saved while a GPU was present; calibrate again rather than exit on the first resize
+        if (entry.choice.backend == BACKEND_CUDA && !cuda_DeviceAvailable()) {
+            return false;
+        }
+        entries.push_back(entry);
+    }
+    return hostMatches && !entries.empty();
+}
+
+static const vector<CalibrationEntry>& calibration() {
+    static vector<CalibrationEntry> entries;
+    static once_flag loaded;
+    call_once(loaded, [] {
+        if (!auto_LoadCalibration(entries)) {
+            cout << "Calibrating resize backends (saved to " << AUTO_CALIBRATION_FILE << ")..." << endl;
+            entries = auto_Calibrate();
+        }
+    });
+    return entries;
+}
+
+ResizeChoice auto_Choose(int dstWidth, int dstHeight, int channels) {
+    const vector<CalibrationEntry>& entries = calibration();
+    double pixels = max(1.0, (double)dstWidth * dstHeight);
+
+    // nearest channel count first, then nearest size on a log scale
+    const CalibrationEntry* best = nullptr;
+    double bestScore = 1e30;
+    for (const CalibrationEntry& entry : entries) {
+        double score = abs(entry.channels - channels) * 100.0 + abs(log(entry.outputPixels / pixels));
+        if (score < bestScore) {
+            bestScore = score;
+            best = &entry;
+        }
+    }
+    return best ? best->choice : ResizeChoice{ BACKEND_OPENMP, omp_get_max_threads(), 0, 0 };
+}
+
+void auto_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels,
+    unsigned char* dst, int dstWidth, int dstHeight) {
+    auto_ResizeBicubic(ImageView(src, srcWidth, srcHeight, channels), ImageView(dst, dstWidth, dstHeight, channels));
+}
+
+void auto_ResizeBicubic(const ImageView& src, const ImageView& dst) {
+    runChoice(auto_Choose(dst.width, dst.height, src.channels), src, dst);
+}
+
+const char* resizeBackendName(ResizeBackend backend) {
+    switch (backend) {
+    case BACKEND_OPENMP: return "openmp";
+    case BACKEND_SIMD: return "simd";
+    case BACKEND_CUDA: return "cuda";
+    default: return "serial";
+    }
+}
+
+string resizeChoiceName(const ResizeChoice& choice) {
+    ostringstream name;
+    name << resizeBackendName(choice.backend) << " x" << choice.threads;
+    if (choice.backend == BACKEND_OPENMP) {
+        if (choice.tileWidth > 0) {
+            name << " tile " << choice.tileWidth << "x" << choice.tileHeight;
+        }
+        else {
+            name << " tile auto";
+        }
+    }
+    return name.str();
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "imageView.h"
+
+enum ResizeBackend {
+    BACKEND_SERIAL,
+    BACKEND_OPENMP,
+    BACKEND_SIMD,
+    BACKEND_CUDA
+};
+
+// What auto_ResizeBicubic runs for a given output; tile size 0 means planTileSize
+struct ResizeChoice {
+    ResizeBackend backend;
+    int threads;
+    int tileWidth, tileHeight;
+};
+
+// One calibrated size class: the fastest choice measured at that output size
+struct CalibrationEntry {
+    int channels;
+    double outputPixels;
+    ResizeChoice choice;
+    double seconds;
+};
+
+// Default calibration file, in the working directory
+const char* const AUTO_CALIBRATION_FILE = "resize_calibration.txt";
+
+// Times every backend / thread count / tile size candidate on a few output
+// sizes and channel counts (a few seconds) and keeps the fastest per class.
+// Candidates whose output differs from serial by more than 1 (e.g. CUDA with
+// no device) are skipped. Saved to path when it is not null.
+std::vector<CalibrationEntry> auto_Calibrate(const char* path = AUTO_CALIBRATION_FILE);
+
+// Loads a saved calibration; fails if it is missing or was made on a host
+// with a different thread count or SIMD level
+bool auto_LoadCalibration(std::vector<CalibrationEntry>& entries, const char* path = AUTO_CALIBRATION_FILE);
+
+// Choice for an output size: the calibrated class closest in pixel count for
+// the nearest calibrated channel count. Loads or runs the calibration on first use.
+ResizeChoice auto_Choose(int dstWidth, int dstHeight, int channels);
+
+// resizeFunc-compatible entry point that runs whatever auto_Choose picks
+void auto_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+void auto_ResizeBicubic(const ImageView& src, const ImageView& dst);
+
+const char* resizeBackendName(ResizeBackend backend);
+std::string resizeChoiceName(const ResizeChoice& choice);
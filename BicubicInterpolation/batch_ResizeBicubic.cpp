@@ -0,0 +1,116 @@
+#include <iostream>
+#include <algorithm>
+#include <memory>
+#include <cstdlib>
+#include <vector>
+#include "resizeCore.h"
+#include "threadPool.h"
+#include "batch_ResizeBicubic.h"
+#include "openMP_ResizeBicubic.h"
+
+using namespace std;
+
+// A whole image or one tile of an image
+struct BatchTask {
+    int job;
+    int x0, y0, x1, y1;
+    double cost;
+};
+
+BatchStrategy batch_ResizeBicubic(const vector<ResizeJob>& jobs) {
+    return batch_ResizeBicubic(ThreadPool::instance(), jobs);
+}
+
+BatchStrategy batch_ResizeBicubic(ThreadPool& pool, const vector<ResizeJob>& jobs) {
+    int threads = pool.workerCount() + 1;
+
+    double totalCost = 0;
+    for (const ResizeJob& job : jobs) {
+        totalCost += (double)job.dstWidth * job.dstHeight;
+    }
+    double tileThreshold = totalCost / (2.0 * threads);
+
+    vector<shared_ptr<const ResizePlan>> plans(jobs.size());
+    vector<BatchTask> tasks;
+    int tiledJobs = 0;
+
+    for (int j = 0; j < (int)jobs.size(); ++j) {
+        const ResizeJob& job = jobs[j];
+        plans[j] = getResizePlan(job.srcWidth, job.srcHeight, job.dstWidth, job.dstHeight);
+        double cost = (double)job.dstWidth * job.dstHeight;
+
+        if (threads == 1 || cost <= tileThreshold) {
+            tasks.push_back(BatchTask{ j, 0, 0, job.dstWidth, job.dstHeight, cost });
+            continue;
+        }
+
+        ++tiledJobs;
+        int tileWidth, tileHeight;
+        planTileSize(*plans[j], job.channels, threads, tileWidth, tileHeight);
+        for (int y0 = 0; y0 < job.dstHeight; y0 += tileHeight) {
+            for (int x0 = 0; x0 < job.dstWidth; x0 += tileWidth) {
+                int x1 = min(x0 + tileWidth, job.dstWidth);
+                int y1 = min(y0 + tileHeight, job.dstHeight);
+                tasks.push_back(BatchTask{ j, x0, y0, x1, y1, (double)(x1 - x0) * (y1 - y0) });
+            }
+        }
+    }
+
+    // largest first, so the small whole images fill the gaps at the end
+    stable_sort(tasks.begin(), tasks.end(), [](const BatchTask& a, const BatchTask& b) { return a.cost > b.cost; });
+
+    pool.parallelFor((int)tasks.size(), [&](int t) {
+        const BatchTask& task = tasks[t];
+        const ResizeJob& job = jobs[task.job];
+        bicubicTileDispatch<unsigned char>(*plans[task.job], job.src, (size_t)job.srcWidth * job.channels, job.channels,
+            job.dst, (size_t)job.dstWidth * job.channels, task.x0, task.y0, task.x1, task.y1);
+    });
+
+    if (tiledJobs == 0) {
+        return BATCH_INTER_IMAGE;
+    }
+    return tiledJobs == (int)jobs.size() ? BATCH_INTRA_IMAGE : BATCH_MIXED;
+}
+
+const char* batchStrategyName(BatchStrategy strategy) {
+    switch (strategy) {
+    case BATCH_INTRA_IMAGE: return "intra-image (tiled)";
+    case BATCH_MIXED: return "mixed";
+    default: return "inter-image";
+    }
+}
+
+int batch_CheckAgainstOpenMP(BatchStrategy& strategy) {
+    // { srcWidth, srcHeight, channels, dstWidth, dstHeight }: the first costs
+    // more than half a thread's share of the batch and gets tiled, the rest run whole
+    const int sizes[][5] = { { 320, 240, 3, 640, 480 }, { 40, 30, 1, 64, 48 }, { 40, 30, 3, 64, 48 },
+        { 41, 29, 4, 63, 47 }, { 57, 33, 2, 29, 17 }, { 40, 30, 3, 21, 16 } };
+    vector<vector<unsigned char>> sources, outputs;
+    vector<ResizeJob> jobs;
+
+    srand(1);
+    for (const auto& size : sizes) {
+        sources.emplace_back((size_t)size[0] * size[1] * size[2]);
+        for (unsigned char& sample : sources.back()) {
+            sample = (unsigned char)(rand() & 255);
+        }
+        outputs.emplace_back((size_t)size[3] * size[4] * size[2]);
+    }
+    for (size_t j = 0; j < sources.size(); ++j) {
+        const int* size = sizes[j];
+        jobs.push_back(ResizeJob{ sources[j].data(), size[0], size[1], size[2], outputs[j].data(), size[3], size[4] });
+    }
+
+    ThreadPool pool(3);
+    strategy = batch_ResizeBicubic(pool, jobs);
+
+    int maxDiff = 0;
+    for (const ResizeJob& job : jobs) {
+        vector<unsigned char> expected((size_t)job.dstWidth * job.dstHeight * job.channels);
+        openMP_ResizeBicubic(job.src, job.srcWidth, job.srcHeight, job.channels, expected.data(), job.dstWidth, job.dstHeight);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            maxDiff = max(maxDiff, abs((int)expected[i] - (int)job.dst[i]));
+        }
+    }
+    return maxDiff;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+
+class ThreadPool;
+
+// One image of a batch resize; src and dst are interleaved 8-bit buffers
+struct ResizeJob {
+    unsigned char* src;
+    int srcWidth, srcHeight, channels;
+    unsigned char* dst;
+    int dstWidth, dstHeight;
+};
+
+// How a batch was split across the pool
+enum BatchStrategy {
+    BATCH_INTER_IMAGE,  // every image resized whole by one thread
+    BATCH_INTRA_IMAGE,  // every image split into tiles
+    BATCH_MIXED         // large images tiled, small ones whole
+};
+
+// Resizes every job on the shared ThreadPool in a single parallel call. The
+// cost of a job is its output pixel count; a job costing more than half a
+// worker's fair share of the batch would leave the others idle if run whole,
+// so it is split into tiles, everything else runs as one task per image.
+BatchStrategy batch_ResizeBicubic(const std::vector<ResizeJob>& jobs);
+
+// Same on a given pool; the split follows that pool's thread count
+BatchStrategy batch_ResizeBicubic(ThreadPool& pool, const std::vector<ResizeJob>& jobs);
+
+const char* batchStrategyName(BatchStrategy strategy);
+
+// Runs one large and several small images, 1 to 4 channels, on a private
+// 4-thread pool so the mixed split is taken on any host, and returns the
+// largest difference against openMP_ResizeBicubic per image; strategy gets
+// the split the batch used
+int batch_CheckAgainstOpenMP(BatchStrategy& strategy);
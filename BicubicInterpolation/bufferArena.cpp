@@ -0,0 +1,178 @@
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include "bufferArena.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+static const size_t cacheLineBytes = 64;
+static const size_t hugePageBytes = (size_t)2 << 20;
+static const size_t smallestClass = 4096;
+
+BufferArena::BufferArena(size_t cacheLimit) : cacheLimit(cacheLimit), useHugePages(false), enabled(true), counters() {}
+
+BufferArena::~BufferArena() {
+    trim();
+}
+
+BufferArena& BufferArena::instance() {
+    static BufferArena arena;
+    return arena;
+}
+
+size_t BufferArena::sizeClass(size_t bytes) {
+    if (bytes <= smallestClass) {
+        return smallestClass;
+    }
+    // (base, 2 * base] is split into four steps of base / 4
+    size_t base = smallestClass;
+    while (base * 2 < bytes) {
+        base *= 2;
+    }
+    size_t step = base / 4;
+    return (bytes + step - 1) / step * step;
+}
+
+void* BufferArena::allocateBlock(size_t bytes) {
+    bool huge = useHugePages && bytes >= hugePageBytes;
+    size_t alignment = huge ? hugePageBytes : cacheLineBytes;
+    void* block = nullptr;
+#if defined(_WIN32)
+    // large pages need SeLockMemoryPrivilege, so Windows only gets the alignment
+    block = _aligned_malloc(bytes, alignment);
+#else
+    if (posix_memalign(&block, alignment, bytes) != 0) {
+        block = nullptr;
+    }
+#if defined(MADV_HUGEPAGE)
+    if (block && huge) {
+        madvise(block, bytes / hugePageBytes * hugePageBytes, MADV_HUGEPAGE);
+    }
+#endif
+#endif
+    if (!block) {
+        throw bad_alloc();
+    }
+    counters.systemAllocations++;
+    return block;
+}
+
+void BufferArena::freeBlock(void* block) {
+#if defined(_WIN32)
+    _aligned_free(block);
+#else
+    free(block);
+#endif
+}
+
+void* BufferArena::acquire(size_t bytes) {
+    if (bytes == 0) {
+        return nullptr;
+    }
+    // class-sized even when disabled, so a block may be released under either setting
+    size_t classBytes = sizeClass(bytes);
+    lock_guard<mutex> lock(arenaMutex);
+    if (!enabled) {
+        return allocateBlock(classBytes);
+    }
+
+    vector<void*>& blocks = freeLists[classBytes];
+    if (blocks.empty()) {
+        return allocateBlock(classBytes);
+    }
+    void* block = blocks.back();
+    blocks.pop_back();
+    counters.cachedBytes -= classBytes;
+    counters.reuses++;
+    return block;
+}
+
+void BufferArena::release(void* block, size_t bytes) {
+    if (!block) {
+        return;
+    }
+    lock_guard<mutex> lock(arenaMutex);
+    size_t classBytes = sizeClass(bytes);
+    if (!enabled || counters.cachedBytes + classBytes > cacheLimit) {
+        freeBlock(block);
+        return;
+    }
+    freeLists[classBytes].push_back(block);
+    counters.cachedBytes += classBytes;
+}
+
+void BufferArena::setHugePages(bool enabledHuge) {
+    trim();
+    lock_guard<mutex> lock(arenaMutex);
+    useHugePages = enabledHuge;
+}
+
+void BufferArena::setEnabled(bool enabledArena) {
+    trim();
+    lock_guard<mutex> lock(arenaMutex);
+    enabled = enabledArena;
+}
+
+void BufferArena::trim() {
+    lock_guard<mutex> lock(arenaMutex);
+    for (auto& entry : freeLists) {
+        for (void* block : entry.second) {
+            freeBlock(block);
+        }
+    }
+    freeLists.clear();
+    counters.cachedBytes = 0;
+}
+
+ArenaStats BufferArena::stats() const {
+    lock_guard<mutex> lock(arenaMutex);
+    return counters;
+}
+
+void BufferArena::resetStats() {
+    lock_guard<mutex> lock(arenaMutex);
+    counters.systemAllocations = 0;
+    counters.reuses = 0;
+}
+
+long long processPageFaults() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS memory;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &memory, sizeof(memory))) {
+        return memory.PageFaultCount;
+    }
+    return 0;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return (long long)usage.ru_minflt + usage.ru_majflt;
+#endif
+}
+
+size_t processPeakResidentBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS memory;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &memory, sizeof(memory))) {
+        return memory.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    // kilobytes on Linux
+    return (size_t)usage.ru_maxrss * 1024;
+#endif
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+struct ArenaStats {
+    size_t systemAllocations;  // blocks taken from the system allocator
+    size_t reuses;             // acquires served from a free list
+    size_t cachedBytes;        // held in the free lists right now
+};
+
+// Size-class cache of large aligned buffers, so repeated resizes stop paying
+// for allocation and first-touch page faults. Classes run four per power of
+// two from 4 KiB up (at most 25% slack); a released block goes back on its
+// class's free list and the next acquire of that class gets it, pages already
+// faulted in. Blocks are 64-byte aligned. With huge pages on, blocks of 2 MiB
+// or more are 2 MiB aligned and, on Linux, advised for transparent huge pages.
+class BufferArena {
+public:
+    // Releases beyond cacheLimit cached bytes go back to the system
+    explicit BufferArena(size_t cacheLimit = (size_t)1 << 30);
+    ~BufferArena();
+
+    BufferArena(const BufferArena&) = delete;
+    BufferArena& operator=(const BufferArena&) = delete;
+
+    // Shared arena used by resizeImage and the separable intermediates
+    static BufferArena& instance();
+
+    // Uninitialized block of at least bytes; nullptr for 0 bytes
+    void* acquire(size_t bytes);
+    void release(void* block, size_t bytes);
+
+    // Drops the cached blocks, so later ones get the new setting
+    void setHugePages(bool enabled);
+    bool hugePages() const { return useHugePages; }
+
+    // Disabled, every acquire and release goes straight to the system
+    // allocator (still counted), as a before/after baseline
+    void setEnabled(bool enabled);
+
+    // Frees every cached block
+    void trim();
+
+    ArenaStats stats() const;
+    void resetStats();
+
+private:
+    static size_t sizeClass(size_t bytes);
+    void* allocateBlock(size_t bytes);
+    static void freeBlock(void* block);
+
+    size_t cacheLimit;
+    bool useHugePages;
+    bool enabled;
+
+    mutable std::mutex arenaMutex;
+    std::map<size_t, std::vector<void*>> freeLists;
+    ArenaStats counters;
+};
+
+// Owning handle of count T borrowed from an arena, returned when it goes out
+// of scope. Contents start uninitialized, so T should be a plain pixel type.
+template<typename T>
+class ArenaBuffer {
+public:
+    explicit ArenaBuffer(size_t count, BufferArena& arena = BufferArena::instance())
+        : arena(&arena), count(count), memory((T*)arena.acquire(count * sizeof(T))) {}
+
+    ~ArenaBuffer() { arena->release(memory, count * sizeof(T)); }
+
+    ArenaBuffer(ArenaBuffer&& other) : arena(other.arena), count(other.count), memory(other.memory) {
+        other.count = 0;
+        other.memory = nullptr;
+    }
+
+    ArenaBuffer(const ArenaBuffer&) = delete;
+    ArenaBuffer& operator=(const ArenaBuffer&) = delete;
+
+    T* data() const { return memory; }
+    size_t size() const { return count; }
+    T& operator[](size_t i) const { return memory[i]; }
+
+private:
+    BufferArena* arena;
+    size_t count;
+    T* memory;
+};
+
+// Page faults (minor + major) taken by the process so far, 0 where the OS does not say
+long long processPageFaults();
+
+// Largest resident set the process has had so far, 0 where the OS does not say
+size_t processPeakResidentBytes();
@@ -0,0 +1,121 @@
+#include <iostream>
+#include "cpuFeatures.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+using namespace std;
+
+static void cpuid(int leaf, int subleaf, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, leaf, subleaf);
+    for (int i = 0; i < 4; ++i) {
+        regs[i] = (unsigned int)r[i];
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// OS-enabled register state (XCR0), needed before trusting the AVX bits
+static unsigned long long xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((unsigned long long)hi << 32) | lo;
+#endif
+}
+
+SimdLevel detectSimdLevel() {
+    unsigned int regs[4];
+
+    cpuid(0, 0, regs);
+    unsigned int maxLeaf = regs[0];
+    if (maxLeaf < 1) {
+        return SIMD_SCALAR;
+    }
+
+    cpuid(1, 0, regs);
+    bool sse41 = (regs[2] & (1u << 19)) != 0;
+    bool fma = (regs[2] & (1u << 12)) != 0;
+    bool osxsave = (regs[2] & (1u << 27)) != 0;
+    bool avx = (regs[2] & (1u << 28)) != 0;
+
+    if (!sse41) {
+        return SIMD_SCALAR;
+    }
+    if (!osxsave || !avx || !fma || maxLeaf < 7) {
+        return SIMD_SSE41;
+    }
+
+    unsigned long long xcr0 = xgetbv0();
+    bool ymmState = (xcr0 & 0x6) == 0x6;    // XMM | YMM
+    bool zmmState = (xcr0 & 0xe6) == 0xe6;  // XMM | YMM | opmask | ZMM
+
+    cpuid(7, 0, regs);
+    bool avx2 = (regs[1] & (1u << 5)) != 0;
+    bool avx512f = (regs[1] & (1u << 16)) != 0;
+    bool avx512bw = (regs[1] & (1u << 30)) != 0;
+
+    if (!avx2 || !ymmState) {
+        return SIMD_SSE41;
+    }
+    if (!avx512f || !avx512bw || !zmmState) {
+        return SIMD_AVX2;
+    }
+    return SIMD_AVX512;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+    case SIMD_SSE41: return "SSE4.1";
+    case SIMD_AVX2: return "AVX2";
+    case SIMD_AVX512: return "AVX-512";
+    default: return "scalar";
+    }
+}
+
+int detectL2CacheBytes() {
+    unsigned int regs[4];
+
+    cpuid(0, 0, regs);
+    unsigned int maxLeaf = regs[0];
+
+    // Intel: deterministic cache parameters, one subleaf per cache
+    if (maxLeaf >= 4) {
+        for (int subleaf = 0; subleaf < 16; ++subleaf) {
+            cpuid(4, subleaf, regs);
+            unsigned int type = regs[0] & 0x1f;
+            if (type == 0) {
+                break;
+            }
+            unsigned int level = (regs[0] >> 5) & 0x7;
+            if (level == 2 && (type == 1 || type == 3)) {
+                unsigned int ways = ((regs[1] >> 22) & 0x3ff) + 1;
+                unsigned int partitions = ((regs[1] >> 12) & 0x3ff) + 1;
+                unsigned int lineSize = (regs[1] & 0xfff) + 1;
+                unsigned int sets = regs[2] + 1;
+                return (int)(ways * partitions * lineSize * sets);
+            }
+        }
+    }
+
+    // AMD: L2 size in KB in ECX[31:16]
+    cpuid(0x80000000, 0, regs);
+    if (regs[0] >= 0x80000006) {
+        cpuid(0x80000006, 0, regs);
+        unsigned int kb = regs[2] >> 16;
+        if (kb > 0) {
+            return (int)(kb * 1024);
+        }
+    }
+
+    return 256 * 1024;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+// Instruction set levels the vectorized paths are built for, in increasing order
+enum SimdLevel {
+    SIMD_SCALAR = 0,
+    SIMD_SSE41 = 1,
+    SIMD_AVX2 = 2,
+    SIMD_AVX512 = 3
+};
+
+SimdLevel detectSimdLevel();
+const char* simdLevelName(SimdLevel level);
+
+// Per-core L2 size in bytes from cpuid, 256 KB if the CPU does not report it
+int detectL2CacheBytes();
@@ -0,0 +1,55 @@
+#pragma once
+#include <cmath>
+
+// Shared with the CUDA kernels
+#if defined(__CUDACC__)
+#define KERNEL_FUNC __host__ __device__ inline
+#else
+#define KERNEL_FUNC inline
+#endif
+
+// Mitchell-Netravali cubic family with B = BNum / Den and C = CNum / Den.
+// The piecewise polynomial coefficients are folded at compile time, so a
+// kernel type carries no state and weight() inlines into the plan builder.
+template<int BNum, int CNum, int Den>
+struct CubicKernel {
+    static constexpr float B = (float)BNum / Den;
+    static constexpr float C = (float)CNum / Den;
+
+    // |d| <= 1
+    static constexpr float near3 = (12.0f - 9.0f * B - 6.0f * C) / 6.0f;
+    static constexpr float near2 = (-18.0f + 12.0f * B + 6.0f * C) / 6.0f;
+    static constexpr float near0 = (6.0f - 2.0f * B) / 6.0f;
+
+    // 1 < |d| <= 2
+    static constexpr float far3 = (-B - 6.0f * C) / 6.0f;
+    static constexpr float far2 = (6.0f * B + 30.0f * C) / 6.0f;
+    static constexpr float far1 = (-12.0f * B - 48.0f * C) / 6.0f;
+    static constexpr float far0 = (8.0f * B + 24.0f * C) / 6.0f;
+
+    // radius in source pixels, 2 * support taps per output sample
+    static constexpr int support = 2;
+
+    // the family sums to 1 analytically, plan weights are used as evaluated
+    static constexpr bool normalized = false;
+
+    KERNEL_FUNC static float weight(float d) {
+        d = fabsf(d);
+        if (d <= 1.0f) {
+            return near3 * d * d * d + near2 * d * d + near0;
+        }
+        else if (d <= 2.0f) {
+            return far3 * d * d * d + far2 * d * d + far1 * d + far0;
+        }
+        return 0.0f;
+    }
+};
+
+// Keys cubic convolution with a = ANum / ADen, i.e. B = 0, C = -a
+template<int ANum, int ADen>
+using KeysKernel = CubicKernel<0, -ANum, ADen>;
+
+typedef KeysKernel<-1, 2> CatmullRomKernel;   // a = -0.5, the original bicubicKernel
+typedef KeysKernel<-3, 4> KeysSharpKernel;    // a = -0.75, sharper, more ringing
+typedef CubicKernel<1, 1, 3> MitchellKernel;  // B = C = 1/3, photographic content
+typedef CubicKernel<1, 0, 1> BSplineKernel;   // B = 1, C = 0, smoothing, no overshoot
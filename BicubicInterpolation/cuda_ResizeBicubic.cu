@@ -1,6 +1,8 @@
 #include <cuda_runtime.h>
 #include <iostream>
 #include "serial_ResizeBicubic.h"
+#include "cuda_ResizeBicubic.cuh"
+#include "cubicKernels.h"
 
 using namespace std;
 
@@ -14,26 +16,15 @@ using namespace std;
         } \
     } while (0)
 
-// Refer to bicubicKernal in bicubicKernel.cpp
-__device__ float cuda_bicubicKernel(float d) {
-    d = fabsf(d);
-    if (d <= 1.0f) {
-        return (1.5f * d * d * d - 2.5f * d * d + 1.0f);
-    }
-    else if (d <= 2.0f) {
-        return (-0.5f * d * d * d + 2.5f * d * d - 4.0f * d + 2.0f);
-    }
-    return 0.0f;
-}
-
 // Refer to cuda_getPixelValue in bicubicKernel.cpp
 __device__ float cuda_getPixelValue(unsigned char* image, int width, int height, int channels, int x, int y, int c) {
     x = max(0, min(x, width - 1));
     y = max(0, min(y, height - 1));
-    return image[(y * width + x) * channels + c];
+    return image[((size_t)y * width + x) * channels + c];
 }
 
-// CUDA kernel for bicubic resizing
+// CUDA kernel for bicubic resizing, Kernel is a filter type from cubicKernels.h
+template<typename Kernel>
 __global__ void cuda_ResizeBicubicKernel(unsigned char* src, int srcWidth, int srcHeight, int channels,
     unsigned char* dst, int dstWidth, int dstHeight, float scaleX, float scaleY) {
     int x = blockIdx.x * blockDim.x + threadIdx.x;
@@ -49,30 +40,33 @@ __global__ void cuda_ResizeBicubicKernel(unsigned char* src, int srcWidth, int s
             float result = 0.0f;
             for (int m = -1; m <= 2; ++m) {
                 for (int n = -1; n <= 2; ++n) {
-                    float weight = cuda_bicubicKernel(srcX - (x1 + n)) * cuda_bicubicKernel(srcY - (y1 + m));
+                    float weight = Kernel::weight(srcX - (x1 + n)) * Kernel::weight(srcY - (y1 + m));
                     result += cuda_getPixelValue(src, srcWidth, srcHeight, channels, x1 + n, y1 + m, c) * weight;
                 }
             }
 
-            dst[(y * dstWidth + x) * channels + c] = min(max((int)result, 0), 255);
+            dst[((size_t)y * dstWidth + x) * channels + c] = min(max((int)result, 0), 255);
         }
     }
 }
 
 // Function to resize the image on the GPU
-void cuda_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels,
-    unsigned char* dst, int dstWidth, int dstHeight) {
+void cuda_ResizeBicubic(const ImageView& src, const ImageView& dst) {
+    int srcWidth = src.width, srcHeight = src.height, channels = src.channels;
+    int dstWidth = dst.width, dstHeight = dst.height;
+    size_t srcRowBytes = (size_t)srcWidth * channels;
+    size_t dstRowBytes = (size_t)dstWidth * channels;
     unsigned char* d_src;
     unsigned char* d_dst;
-    size_t srcSize = srcWidth * srcHeight * channels * sizeof(unsigned char);
-    size_t dstSize = dstWidth * dstHeight * channels * sizeof(unsigned char);
+    size_t srcSize = srcRowBytes * srcHeight * sizeof(unsigned char);
+    size_t dstSize = dstRowBytes * dstHeight * sizeof(unsigned char);
 
     // Allocate device memory
     CUDA_CHECK(cudaMalloc((void**)&d_src, srcSize));
     CUDA_CHECK(cudaMalloc((void**)&d_dst, dstSize));
 
     // Copy data to device
-    CUDA_CHECK(cudaMemcpy(d_src, src, srcSize, cudaMemcpyHostToDevice));
+    CUDA_CHECK(cudaMemcpy2D(d_src, srcRowBytes, src.data, src.pitch, srcRowBytes, srcHeight, cudaMemcpyHostToDevice));
 
     float scaleX = (float)srcWidth / dstWidth;
     float scaleY = (float)srcHeight / dstHeight;
@@ -82,14 +76,25 @@ void cuda_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int cha
     dim3 gridSize((dstWidth + blockSize.x - 1) / blockSize.x, (dstHeight + blockSize.y - 1) / blockSize.y);
 
     // Launch the CUDA kernel
-    cuda_ResizeBicubicKernel << <gridSize, blockSize >> > (d_src, srcWidth, srcHeight, channels, d_dst, dstWidth, dstHeight, scaleX, scaleY);
+    cuda_ResizeBicubicKernel<CatmullRomKernel> << <gridSize, blockSize >> > (d_src, srcWidth, srcHeight, channels, d_dst, dstWidth, dstHeight, scaleX, scaleY);
     cudaDeviceSynchronize();  // Ensure the kernel finishes before moving on
 
 
     // Copy the result back to host
-    CUDA_CHECK(cudaMemcpy(dst, d_dst, dstSize, cudaMemcpyDeviceToHost));
+    CUDA_CHECK(cudaMemcpy2D(dst.data, dst.pitch, d_dst, dstRowBytes, dstRowBytes, dstHeight, cudaMemcpyDeviceToHost));
 
     // Free device memory
     CUDA_CHECK(cudaFree(d_src));
     CUDA_CHECK(cudaFree(d_dst));
 }
+
+void cuda_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels,
+    unsigned char* dst, int dstWidth, int dstHeight) {
+    cuda_ResizeBicubic(ImageView(src, srcWidth, srcHeight, channels), ImageView(dst, dstWidth, dstHeight, channels));
+}
+
+bool cuda_DeviceAvailable() {
+    // queried directly rather than through CUDA_CHECK, which exits on failure
+    int devices = 0;
+    return cudaGetDeviceCount(&devices) == cudaSuccess && devices > 0;
+}
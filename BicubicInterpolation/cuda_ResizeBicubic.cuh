@@ -1,2 +1,10 @@
 #pragma once
-void cuda_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
\ No newline at end of file
+#include "imageView.h"
+void cuda_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+
+// Strided host views; the transfers are 2D copies, device buffers stay packed
+void cuda_ResizeBicubic(const ImageView& src, const ImageView& dst);
+
+// True when the CUDA runtime loads and reports at least one device; every
+// other entry point exits the process on a CUDA error
+bool cuda_DeviceAvailable();
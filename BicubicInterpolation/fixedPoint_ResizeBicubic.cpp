@@ -0,0 +1,172 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <omp.h>
+#include "fixedPoint_ResizeBicubic.h"
+#include "simdKernels.h"
+#include "simd_ResizeBicubic.h"
+#include "serial_ResizeBicubic.h"
+#include "bufferArena.h"
+#include "resizeCore.h"
+
+using namespace std;
+
+void horizontalQ14_Scalar(const short* srcRow, short* tmpRow, const int* laneIndex, const short* laneWeight, int lanes, int taps) {
+    horizontalLanesQ14(srcRow, tmpRow, laneIndex, laneWeight, lanes, taps, 0);
+}
+
+void verticalQ14_Scalar(const short* const* rows, const short* weight, int taps, unsigned char* dstRow, int lanes) {
+    verticalLanesQ14(rows, weight, taps, dstRow, lanes, 0);
+}
+
+// AVX-512 machines run the AVX2 kernels
+static FixedPointKernels fixedPointKernelsFor(SimdLevel level) {
+    if (level >= SIMD_AVX2) {
+        return { horizontalQ14_AVX2, verticalQ14_AVX2 };
+    }
+    return { horizontalQ14_Scalar, verticalQ14_Scalar };
+}
+
+// Round one output sample's weights to Q14, pushing the rounding error into
+// the largest tap so every set still sums to exactly 1.0
+static void quantizeWeights(const float* weight, int taps, short* fixedWeight) {
+    const int one = 1 << FIXED_WEIGHT_BITS;
+    int sum = 0;
+    int largest = 0;
+
+    for (int k = 0; k < taps; ++k) {
+        int value = (int)lround(weight[k] * one);
+        fixedWeight[k] = (short)value;
+        sum += value;
+        if (fabs(weight[k]) > fabs(weight[largest])) {
+            largest = k;
+        }
+    }
+    fixedWeight[largest] = (short)(fixedWeight[largest] + (one - sum));
+}
+
+void fixedPoint_ResizeBicubic(const ResizePlan& plan, const ImageView& src, const ImageView& dst, SimdLevel level) {
+    int channels = src.channels;
+    int srcWidth = plan.srcWidth;
+    int srcHeight = plan.srcHeight;
+    int dstWidth = plan.dstWidth;
+    int dstHeight = plan.dstHeight;
+    int xTaps = plan.xTaps;
+    int yTaps = plan.yTaps;
+    int lanes = dstWidth * channels;
+    FixedPointKernels kernels = fixedPointKernelsFor(level);
+
+    // per-lane column tables, as in simd_ResizeBicubic, with Q14 weights
+    ArenaBuffer<int> laneIndex((size_t)xTaps * lanes);
+    ArenaBuffer<short> laneWeight((size_t)xTaps * lanes);
+    vector<short> fixedWeight(xTaps);
+    for (int x = 0; x < dstWidth; ++x) {
+        quantizeWeights(&plan.xWeight[x * xTaps], xTaps, fixedWeight.data());
+        for (int k = 0; k < xTaps; ++k) {
+            for (int c = 0; c < channels; ++c) {
+                laneIndex[(size_t)k * lanes + x * channels + c] = plan.xIndex[x * xTaps + k] * channels + c;
+                laneWeight[(size_t)k * lanes + x * channels + c] = fixedWeight[k];
+            }
+        }
+    }
+
+    vector<short> rowWeight((size_t)dstHeight * yTaps);
+    for (int y = 0; y < dstHeight; ++y) {
+        quantizeWeights(&plan.yWeight[y * yTaps], yTaps, &rowWeight[y * yTaps]);
+    }
+
+    // virtual BORDER_CONSTANT pixel/row appended as in simd_ResizeBicubic,
+    // plus one spare element so 32-bit gathers may read past the last sample
+    bool constant = plan.border == BORDER_CONSTANT;
+    ArenaBuffer<short> tmp((size_t)(srcHeight + (constant ? 1 : 0)) * lanes);
+    vector<short> constantRow((size_t)(srcWidth + 1) * channels + 1, 0);
+    for (size_t i = 0; i + 1 < constantRow.size(); ++i) {
+        constantRow[i] = borderPixel<unsigned char>(plan, (int)(i % channels));
+    }
+
+    if (constant) {
+        kernels.horizontal(constantRow.data(), &tmp[(size_t)srcHeight * lanes], laneIndex.data(), laneWeight.data(), lanes, xTaps);
+    }
+
+    // horizontal pass: source rows -> int16 intermediate
+    #pragma omp parallel
+    {
+        vector<short> srcRow16(constantRow);
+
+        #pragma omp for
+        for (int y = 0; y < srcHeight; ++y) {
+            const unsigned char* srcRow = src.row(y);
+            for (int i = 0; i < srcWidth * channels; ++i) {
+                srcRow16[i] = srcRow[i];
+            }
+            kernels.horizontal(srcRow16.data(), &tmp[(size_t)y * lanes], laneIndex.data(), laneWeight.data(), lanes, xTaps);
+        }
+    }
+
+    // vertical pass: intermediate -> destination rows
+    #pragma omp parallel
+    {
+        vector<const short*> rows(yTaps);
+
+        #pragma omp for
+        for (int y = 0; y < dstHeight; ++y) {
+            for (int m = 0; m < yTaps; ++m) {
+                rows[m] = &tmp[(size_t)plan.yIndex[y * yTaps + m] * lanes];
+            }
+            kernels.vertical(rows.data(), &rowWeight[y * yTaps], yTaps, dst.row(y), lanes);
+        }
+    }
+}
+
+void fixedPoint_ResizeBicubic(const ResizePlan& plan, unsigned char* src, int channels, unsigned char* dst, SimdLevel level) {
+    fixedPoint_ResizeBicubic(plan, ImageView(src, plan.srcWidth, plan.srcHeight, channels),
+        ImageView(dst, plan.dstWidth, plan.dstHeight, channels), level);
+}
+
+void fixedPoint_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels,
+    unsigned char* dst, int dstWidth, int dstHeight) {
+    fixedPoint_ResizeBicubic(*getResizePlan(srcWidth, srcHeight, dstWidth, dstHeight), src, channels, dst, simd_ActiveLevel());
+}
+
+void fixedPoint_ResizeBicubic(const ImageView& src, const ImageView& dst) {
+    fixedPoint_ResizeBicubic(*getResizePlan(src.width, src.height, dst.width, dst.height), src, dst, simd_ActiveLevel());
+}
+
+int fixedPoint_CheckAgainstSerial(SimdLevel level, double& mismatched) {
+    const int sizes[][4] = { { 157, 93, 411, 250 }, { 157, 93, 61, 37 } };
+    // clamped edges, and a constant colour outside [0, 255] that must saturate alike
+    const BorderMode borders[] = { BORDER_CLAMP, BORDER_CONSTANT };
+    const vector<float> borderColor = { 300.0f, -20.0f, 128.6f, 255.0f };
+    int maxDiff = 0;
+    size_t differing = 0;
+    size_t total = 0;
+
+    srand(1);
+    for (const auto& size : sizes) {
+        for (BorderMode border : borders) {
+            for (int channels = 1; channels <= 4; ++channels) {
+                vector<unsigned char> src((size_t)size[0] * size[1] * channels);
+                for (size_t i = 0; i < src.size(); ++i) {
+                    src[i] = (unsigned char)(rand() & 255);
+                }
+
+                vector<unsigned char> expected((size_t)size[2] * size[3] * channels);
+                vector<unsigned char> actual(expected.size());
+                const ResizePlan plan(size[0], size[1], size[2], size[3], CatmullRomKernel(), border, borderColor);
+                serial_ResizeBicubic(plan, src.data(), channels, expected.data());
+                fixedPoint_ResizeBicubic(plan, src.data(), channels, actual.data(), level);
+
+                for (size_t i = 0; i < expected.size(); ++i) {
+                    int diff = abs((int)expected[i] - (int)actual[i]);
+                    maxDiff = max(maxDiff, diff);
+                    differing += diff != 0;
+                }
+                total += expected.size();
+            }
+        }
+    }
+
+    mismatched = (double)differing / total;
+    return maxDiff;
+}
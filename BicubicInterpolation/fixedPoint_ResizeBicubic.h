@@ -0,0 +1,20 @@
+#pragma once
+#include "resizePlan.h"
+#include "cpuFeatures.h"
+#include "imageView.h"
+
+// 8-bit integer bicubic resize: Q14 weights, int16 intermediates, rounding
+// shift at the end. Against serial_ResizeBicubic (float, truncating) the
+// output differs by at most 1 on 1-4 channel up- and downscales; about half
+// of all samples round up by 1 because serial truncates instead of rounding
+// (see fixedPoint_CheckAgainstSerial).
+void fixedPoint_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+void fixedPoint_ResizeBicubic(const ResizePlan& plan, unsigned char* src, int channels, unsigned char* dst, SimdLevel level);
+
+// Strided source and destination; the plan sizes are the view sizes
+void fixedPoint_ResizeBicubic(const ResizePlan& plan, const ImageView& src, const ImageView& dst, SimdLevel level);
+void fixedPoint_ResizeBicubic(const ImageView& src, const ImageView& dst);
+
+// Largest per-sample difference against serial_ResizeBicubic on a synthetic
+// image; mismatched receives the fraction of samples that differ at all
+int fixedPoint_CheckAgainstSerial(SimdLevel level, double& mismatched);
@@ -41,7 +41,7 @@ double resizeImage(void (*resizeFunc)(unsigned char*, int, int, int, unsigned ch
         return -1;
     }
 
-    unsigned char* resizedImg = new unsigned char[newWidth * newHeight * channels];
+    unsigned char* resizedImg = new unsigned char[(size_t)newWidth * newHeight * channels];
     double start_time = omp_get_wtime();
     resizeFunc(img, width, height, channels, resizedImg, newWidth, newHeight);
     double run_time = omp_get_wtime() - start_time;
@@ -60,15 +60,15 @@ double resizeImage(void (*resizeFunc)(unsigned char*, int, int, int, unsigned ch
 // Function to calculate Mean Squared Error (MSE) between two images
 double calculateMSE(const unsigned char* img1, const unsigned char* img2, int width, int height, int channels) {
     double mse = 0.0;
-    int totalPixels = width * height * channels;
+    ptrdiff_t totalSamples = (ptrdiff_t)width * height * channels;
 
-#pragma omp parallel for
-    for (int i = 0; i < totalPixels; ++i) {
+#pragma omp parallel for reduction(+:mse)
+    for (ptrdiff_t i = 0; i < totalSamples; ++i) {
         double diff = (double)img1[i] - (double)img2[i];
         mse += diff * diff;
     }
 
-    return mse / totalPixels;
+    return mse / totalSamples;
 }
 
 // Function to generate output file names based on input file and method
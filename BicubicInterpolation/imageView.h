@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <algorithm>
+
+// Non-owning view of an interleaved 8-bit image. pitch is the distance in
+// bytes between the starts of consecutive rows, at least width * channels. A
+// region of a larger image keeps the parent's pitch, so resizing a crop, or
+// writing into part of a bigger canvas, never copies pixels.
+struct ImageView {
+    unsigned char* data;
+    int width, height, channels;
+    size_t pitch;
+
+    ImageView() : data(nullptr), width(0), height(0), channels(0), pitch(0) {}
+
+    // pitch 0 means tightly packed rows
+    ImageView(unsigned char* data, int width, int height, int channels, size_t pitch = 0)
+        : data(data), width(width), height(height), channels(channels), pitch(pitch ? pitch : (size_t)width * channels) {}
+
+    unsigned char* row(int y) const { return data + (size_t)y * pitch; }
+    unsigned char* pixel(int x, int y) const { return row(y) + (size_t)x * channels; }
+    bool packed() const { return pitch == (size_t)width * channels; }
+
+    // [x, x + w) x [y, y + h), clipped to this view
+    ImageView region(int x, int y, int w, int h) const {
+        int x0 = std::min(std::max(x, 0), width);
+        int y0 = std::min(std::max(y, 0), height);
+        int x1 = std::min(std::max(x + w, x0), width);
+        int y1 = std::min(std::max(y + h, y0), height);
+        return ImageView(pixel(x0, y0), x1 - x0, y1 - y0, channels, pitch);
+    }
+};
+
+// View counterpart of the resizeFunc signature; src and dst carry their own sizes
+typedef void (*ViewResizeFunc)(const ImageView& src, const ImageView& dst);
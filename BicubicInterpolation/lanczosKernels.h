@@ -0,0 +1,51 @@
+#pragma once
+#include <cmath>
+#include <vector>
+
+// Lanczos windowed sinc with Lobes lobes: sinc(d) * sinc(d / Lobes) for
+// |d| < Lobes. sin() is evaluated once per table entry; weight() linearly
+// interpolates a table with lutResolution samples per source pixel, so plan
+// building costs no more than for the cubic kernels.
+template<int Lobes>
+struct LanczosKernel {
+    static constexpr int support = Lobes;
+    static constexpr bool normalized = true;
+    static constexpr int lutResolution = 1024;
+
+    static float weight(float d) {
+        static const std::vector<float> lut = buildTable();
+
+        float position = fabsf(d) * lutResolution;
+        int i = (int)position;
+        if (i >= Lobes * lutResolution) {
+            return 0.0f;
+        }
+        float t = position - i;
+        return lut[i] + (lut[i + 1] - lut[i]) * t;
+    }
+
+private:
+    static double exact(double d) {
+        const double pi = 3.14159265358979323846;
+        if (d == 0.0) {
+            return 1.0;
+        }
+        if (d >= Lobes) {
+            return 0.0;
+        }
+        double x = pi * d;
+        return Lobes * sin(x) * sin(x / Lobes) / (x * x);
+    }
+
+    static std::vector<float> buildTable() {
+        // one extra entry so interpolation at the last sample stays in range
+        std::vector<float> lut(Lobes * lutResolution + 1);
+        for (size_t i = 0; i < lut.size(); ++i) {
+            lut[i] = (float)exact((double)i / lutResolution);
+        }
+        return lut;
+    }
+};
+
+typedef LanczosKernel<2> Lanczos2Kernel;
+typedef LanczosKernel<3> Lanczos3Kernel;
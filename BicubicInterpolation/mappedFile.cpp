@@ -0,0 +1,243 @@
+#include <iostream>
+#include <algorithm>
+#include "mappedFile.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#if defined(_WIN32)
+MappedFile::MappedFile() : memory(nullptr), bytes(0), canWrite(false), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {}
+#else
+MappedFile::MappedFile() : memory(nullptr), bytes(0), canWrite(false), descriptor(-1) {}
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+size_t MappedFile::pageBytes() {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return (size_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+#if defined(_WIN32)
+
+// Maps fileHandle (already open) at length bytes
+static unsigned char* mapHandle(HANDLE file, size_t length, bool writable, HANDLE& mapping) {
+    mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+        (DWORD)((unsigned long long)length >> 32), (DWORD)length, nullptr);
+    if (!mapping) {
+        return nullptr;
+    }
+    void* view = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, length);
+    if (!view) {
+        CloseHandle(mapping);
+        mapping = nullptr;
+    }
+    return (unsigned char*)view;
+}
+
+bool MappedFile::open(const string& path, bool writable) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER length;
+    if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &length) || length.QuadPart == 0) {
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+        return false;
+    }
+
+    HANDLE mapping;
+    memory = mapHandle(file, (size_t)length.QuadPart, writable, mapping);
+    if (!memory) {
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    bytes = (size_t)length.QuadPart;
+    canWrite = writable;
+    return true;
+}
+
+bool MappedFile::create(const string& path, size_t length) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    // the mapping extends the file to length
+    HANDLE mapping;
+    memory = mapHandle(file, max(length, (size_t)1), true, mapping);
+    if (!memory) {
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    bytes = length;
+    canWrite = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (!memory) {
+        return;
+    }
+    if (canWrite) {
+        flush();
+    }
+    UnmapViewOfFile(memory);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    memory = nullptr;
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+    bytes = 0;
+}
+
+#else
+
+bool MappedFile::open(const string& path, bool writable) {
+    close();
+    int file = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+    struct stat info;
+    if (file < 0 || fstat(file, &info) != 0 || info.st_size == 0) {
+        if (file >= 0) {
+            ::close(file);
+        }
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, (size_t)info.st_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, 0);
+    if (mapped == MAP_FAILED) {
+        ::close(file);
+        return false;
+    }
+    memory = (unsigned char*)mapped;
+    bytes = (size_t)info.st_size;
+    canWrite = writable;
+    descriptor = file;
+    return true;
+}
+
+bool MappedFile::create(const string& path, size_t length) {
+    close();
+    int file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0) {
+        return false;
+    }
+
+    // a sparse file: blocks are only allocated as pages are written back
+    if (ftruncate(file, (off_t)length) != 0) {
+        ::close(file);
+        return false;
+    }
+    void* mapped = mmap(nullptr, max(length, (size_t)1), PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    if (mapped == MAP_FAILED) {
+        ::close(file);
+        return false;
+    }
+    memory = (unsigned char*)mapped;
+    bytes = length;
+    canWrite = true;
+    descriptor = file;
+    return true;
+}
+
+void MappedFile::close() {
+    if (!memory) {
+        return;
+    }
+    if (canWrite) {
+        flush();
+    }
+    munmap(memory, max(bytes, (size_t)1));
+    ::close(descriptor);
+    memory = nullptr;
+    descriptor = -1;
+    bytes = 0;
+}
+
+#endif
+
+bool MappedFile::pageRange(size_t& offset, size_t& length, bool inner) const {
+    size_t page = pageBytes();
+    size_t end = min(offset + length, bytes);
+    if (inner) {
+        // the end of the file counts as a page edge
+        offset = (offset + page - 1) / page * page;
+        end = end == bytes ? end : end / page * page;
+    }
+    else {
+        offset = offset / page * page;
+    }
+    if (end <= offset) {
+        return false;
+    }
+    length = end - offset;
+    return true;
+}
+
+void MappedFile::prefetch(size_t offset, size_t length) const {
+    if (!memory || !pageRange(offset, length, false)) {
+        return;
+    }
+#if !defined(_WIN32)
+    // readahead for the whole range at once, then the touches below only map pages in
+    madvise(memory + offset, length, MADV_WILLNEED);
+#endif
+    size_t page = pageBytes();
+    volatile unsigned char sink = 0;
+    for (size_t i = 0; i < length; i += page) {
+        sink = sink + memory[offset + i];
+    }
+    (void)sink;
+}
+
+void MappedFile::release(size_t offset, size_t length) const {
+    // a page only partly in the range may still be in use by a neighbour, keep it
+    if (!memory || !pageRange(offset, length, true)) {
+        return;
+    }
+#if defined(_WIN32)
+    if (canWrite) {
+        FlushViewOfFile(memory + offset, length);
+    }
+    // unlocking pages that are not locked trims them from the working set
+    VirtualUnlock(memory + offset, length);
+#else
+    if (canWrite) {
+        msync(memory + offset, length, MS_ASYNC);
+    }
+    // shared file pages: dirty ones stay in the page cache and reach the file
+    madvise(memory + offset, length, MADV_DONTNEED);
+#endif
+}
+
+bool MappedFile::flush() const {
+    if (!memory || !canWrite) {
+        return true;
+    }
+#if defined(_WIN32)
+    return FlushViewOfFile(memory, 0) && FlushFileBuffers((HANDLE)fileHandle);
+#else
+    return msync(memory, max(bytes, (size_t)1), MS_SYNC) == 0;
+#endif
+}
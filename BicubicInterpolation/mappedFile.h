@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// A whole file mapped into memory. Pages come in from disk on first access
+// and, for writable mappings, go back to the file; prefetch and release let
+// a caller that walks the file in order keep only a window of it resident.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps an existing file; false if it cannot be opened or is empty
+    bool open(const std::string& path, bool writable = false);
+
+    // Creates (or truncates) path at bytes long and maps it writable
+    bool create(const std::string& path, size_t bytes);
+
+    // Unmaps; a writable mapping is flushed first
+    void close();
+
+    bool isOpen() const { return memory != nullptr; }
+    bool writable() const { return canWrite; }
+    unsigned char* data() const { return memory; }
+    size_t size() const { return bytes; }
+
+    // Starts reading [offset, offset + length) in and faults it into this
+    // process, so the thread that uses it next does not wait on the disk
+    void prefetch(size_t offset, size_t length) const;
+
+    // Drops [offset, offset + length) from the working set; writable ranges
+    // are written back first, so nothing is lost, only paged out
+    void release(size_t offset, size_t length) const;
+
+    // Writes every dirty page back to the file
+    bool flush() const;
+
+    static size_t pageBytes();
+
+private:
+    // [offset, offset + length) clipped to the mapping and widened to whole
+    // pages, or with inner set shrunk to the pages it covers completely
+    bool pageRange(size_t& offset, size_t& length, bool inner) const;
+
+    unsigned char* memory;
+    size_t bytes;
+    bool canWrite;
+#if defined(_WIN32)
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int descriptor;
+#endif
+};
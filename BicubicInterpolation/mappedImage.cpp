@@ -0,0 +1,221 @@
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include "mappedImage.h"
+
+using namespace std;
+
+static const char rawMagic[8] = { 'B', 'C', 'R', 'A', 'W', '1', '\0', '\0' };
+
+// a page of header keeps raw pixels page-aligned, as in TiledImage
+static const uint32_t rawHeaderBytes = 4096;
+
+MappedImageFormat mappedImageFormat(const string& path) {
+    size_t dot = path.find_last_of('.');
+    string extension = dot == string::npos ? "" : path.substr(dot + 1);
+    transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)tolower(c); });
+    if (extension == "ppm") {
+        return MAPPED_PPM;
+    }
+    if (extension == "pgm") {
+        return MAPPED_PGM;
+    }
+    if (extension == "pam") {
+        return MAPPED_PAM;
+    }
+    if (extension == "raw") {
+        return MAPPED_RAW;
+    }
+    return MAPPED_UNKNOWN;
+}
+
+// Reads the text header of a PNM or PAM file, which ends wherever its fields do
+class HeaderReader {
+public:
+    HeaderReader(const unsigned char* data, size_t size, size_t pos) : data(data), size(size), pos(pos) {}
+
+    // whitespace and # comments
+    void skipSpace() {
+        while (pos < size && (isspace(data[pos]) || data[pos] == '#')) {
+            if (data[pos] == '#') {
+                skipLine();
+            }
+            else {
+                ++pos;
+            }
+        }
+    }
+
+    void skipLine() {
+        while (pos < size && data[pos] != '\n') {
+            ++pos;
+        }
+        pos = min(pos + 1, size);
+    }
+
+    bool readInt(int& value) {
+        skipSpace();
+        long long parsed = 0;
+        size_t start = pos;
+        while (pos < size && isdigit(data[pos]) && parsed <= INT32_MAX) {
+            parsed = parsed * 10 + (data[pos++] - '0');
+        }
+        value = (int)parsed;
+        return pos > start && parsed <= INT32_MAX;
+    }
+
+    string readWord() {
+        skipSpace();
+        size_t start = pos;
+        while (pos < size && !isspace(data[pos])) {
+            ++pos;
+        }
+        return string((const char*)data + start, pos - start);
+    }
+
+    // Exactly one whitespace byte ends the header
+    bool endHeader() {
+        if (pos >= size || !isspace(data[pos])) {
+            return false;
+        }
+        ++pos;
+        return true;
+    }
+
+    size_t position() const { return pos; }
+
+private:
+    const unsigned char* data;
+    size_t size, pos;
+};
+
+// Parses the header at data; the pixel offset, or 0 if it is not an 8-bit image we can map
+static size_t parseHeader(const unsigned char* data, size_t size, MappedImageFormat& kind, int& width, int& height, int& channels) {
+    if (size >= sizeof(RawImageHeader) && memcmp(data, rawMagic, sizeof(rawMagic)) == 0) {
+        RawImageHeader header;
+        memcpy(&header, data, sizeof(header));
+        kind = MAPPED_RAW;
+        width = (int)header.width;
+        height = (int)header.height;
+        channels = (int)header.channels;
+        return header.headerBytes >= sizeof(header) && header.width <= INT32_MAX && header.height <= INT32_MAX ? header.headerBytes : 0;
+    }
+    if (size < 3 || data[0] != 'P') {
+        return 0;
+    }
+
+    HeaderReader reader(data, size, 2);
+    int maxValue = 0;
+    if (data[1] == '5' || data[1] == '6') {
+        kind = data[1] == '5' ? MAPPED_PGM : MAPPED_PPM;
+        channels = data[1] == '5' ? 1 : 3;
+        if (!reader.readInt(width) || !reader.readInt(height) || !reader.readInt(maxValue) || !reader.endHeader()) {
+            return 0;
+        }
+    }
+    else if (data[1] == '7') {
+        kind = MAPPED_PAM;
+        width = height = channels = 0;
+        for (;;) {
+            string key = reader.readWord();
+            if (key.empty()) {
+                return 0;
+            }
+            if (key == "ENDHDR") {
+                // the rest of the ENDHDR line
+                reader.skipLine();
+                break;
+            }
+            bool parsed = true;
+            if (key == "WIDTH") {
+                parsed = reader.readInt(width);
+            }
+            else if (key == "HEIGHT") {
+                parsed = reader.readInt(height);
+            }
+            else if (key == "DEPTH") {
+                parsed = reader.readInt(channels);
+            }
+            else if (key == "MAXVAL") {
+                parsed = reader.readInt(maxValue);
+            }
+            else {
+                // TUPLTYPE and anything else we do not need
+                reader.skipLine();
+            }
+            if (!parsed) {
+                return 0;
+            }
+        }
+    }
+    else {
+        return 0;
+    }
+    return maxValue == 255 ? reader.position() : 0;
+}
+
+bool MappedImage::open(const string& path, bool writable) {
+    close();
+    if (!file.open(path, writable)) {
+        return false;
+    }
+
+    int width = 0, height = 0, channels = 0;
+    size_t offset = parseHeader(file.data(), file.size(), kind, width, height, channels);
+    bool valid = offset > 0 && width > 0 && height > 0 && channels >= 1 && channels <= 4
+        && offset <= file.size() && (size_t)width * height * channels <= file.size() - offset;
+    if (!valid) {
+        cerr << "Not a mappable 8-bit PPM/PGM/PAM/raw image: " << path << endl;
+        close();
+        return false;
+    }
+    pixels = ImageView(file.data() + offset, width, height, channels);
+    return true;
+}
+
+bool MappedImage::create(const string& path, int width, int height, int channels) {
+    close();
+    MappedImageFormat format = mappedImageFormat(path);
+    bool fits = (format == MAPPED_PPM && channels == 3) || (format == MAPPED_PGM && channels == 1)
+        || ((format == MAPPED_PAM || format == MAPPED_RAW) && channels >= 1 && channels <= 4);
+    if (!fits) {
+        cerr << "Cannot write a " << channels << "-channel image as " << path << endl;
+        return false;
+    }
+
+    string header;
+    if (format == MAPPED_PPM || format == MAPPED_PGM) {
+        header = string(format == MAPPED_PPM ? "P6" : "P5") + "\n" + to_string(width) + " " + to_string(height) + "\n255\n";
+    }
+    else if (format == MAPPED_PAM) {
+        const char* tupleTypes[] = { "GRAYSCALE", "GRAYSCALE_ALPHA", "RGB", "RGB_ALPHA" };
+        header = "P7\nWIDTH " + to_string(width) + "\nHEIGHT " + to_string(height) + "\nDEPTH " + to_string(channels)
+            + "\nMAXVAL 255\nTUPLTYPE " + tupleTypes[channels - 1] + "\nENDHDR\n";
+    }
+    else {
+        RawImageHeader raw = {};
+        memcpy(raw.magic, rawMagic, sizeof(rawMagic));
+        raw.headerBytes = rawHeaderBytes;
+        raw.width = width;
+        raw.height = height;
+        raw.channels = channels;
+        header.assign(rawHeaderBytes, '\0');
+        memcpy(&header[0], &raw, sizeof(raw));
+    }
+
+    if (!file.create(path, header.size() + (size_t)width * height * channels)) {
+        cerr << "Failed to create image: " << path << endl;
+        return false;
+    }
+    memcpy(file.data(), header.data(), header.size());
+    kind = format;
+    pixels = ImageView(file.data() + header.size(), width, height, channels);
+    return true;
+}
+
+void MappedImage::close() {
+    file.close();
+    pixels = ImageView();
+    kind = MAPPED_UNKNOWN;
+}
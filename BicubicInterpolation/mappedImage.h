@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "imageView.h"
+#include "mappedFile.h"
+
+// Uncompressed formats whose pixels sit in the file exactly as ImageView
+// wants them, so a mapping of the file is the image: binary PPM (P6, RGB),
+// PGM (P5, gray), PAM (P7, 1-4 channels) and a headered raw format. All at
+// 8 bits per sample (MAXVAL 255).
+enum MappedImageFormat { MAPPED_PPM, MAPPED_PGM, MAPPED_PAM, MAPPED_RAW, MAPPED_UNKNOWN };
+
+// Header of the raw format; pixels start at headerBytes, one page in, tightly packed
+struct RawImageHeader {
+    char magic[8];  // "BCRAW1\0"
+    uint32_t headerBytes;
+    uint32_t width, height, channels;
+};
+
+// Format named by the file extension (.ppm, .pgm, .pam, .raw)
+MappedImageFormat mappedImageFormat(const std::string& path);
+
+class MappedImage {
+public:
+    MappedImage() : kind(MAPPED_UNKNOWN) {}
+
+    // Maps an existing image file and parses its header; false if it is
+    // missing, truncated or not one of the formats above
+    bool open(const std::string& path, bool writable = false);
+
+    // Creates path for width x height x channels in the format its extension
+    // names, header written and every pixel 0; false if the format cannot
+    // hold that many channels
+    bool create(const std::string& path, int width, int height, int channels);
+
+    void close();
+    bool flush() const { return file.flush(); }
+
+    // The pixels, in place in the mapping
+    const ImageView& view() const { return pixels; }
+    MappedImageFormat format() const { return kind; }
+    int width() const { return pixels.width; }
+    int height() const { return pixels.height; }
+    int channels() const { return pixels.channels; }
+
+private:
+    MappedFile file;
+    ImageView pixels;
+    MappedImageFormat kind;
+};
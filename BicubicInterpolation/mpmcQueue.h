@@ -0,0 +1,103 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Bounded multi-producer/multi-consumer ring after Dmitry Vyukov. Every cell
+// carries a sequence number saying whose turn it is: sequence == pos means
+// free for the producer claiming pos, sequence == pos + 1 means filled for
+// the consumer claiming pos. A push or pop is one CAS on its own position
+// counter plus one store to the cell, never a lock, and producers and
+// consumers only meet on cells that are actually in flight.
+//
+// tryPush fails instead of waiting when the ring is full, which is the
+// back-pressure signal; callers choose whether to retry, wait or shed load.
+// Capacity is rounded up to a power of two.
+template<typename T>
+class MpmcQueue {
+public:
+    explicit MpmcQueue(size_t requestedCapacity) : enqueuePos(0), dequeuePos(0) {
+        size_t capacity = 2;
+        while (capacity < requestedCapacity) {
+            capacity *= 2;
+        }
+        mask = capacity - 1;
+        cells.reset(new Cell[capacity]);
+        for (size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    bool tryPush(T&& value) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)pos;
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                // the consumer of the previous lap has not freed this cell: full
+                return false;
+            }
+            else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& value) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    // free the cell for the producer one lap ahead
+                    cell.sequence.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0) {
+                // not filled yet: empty, or its producer is still writing
+                return false;
+            }
+            else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    // Claimed pushes minus claimed pops; only a hint while other threads run
+    size_t sizeApprox() const {
+        size_t popped = dequeuePos.load();
+        size_t pushed = enqueuePos.load();
+        return pushed > popped ? pushed - popped : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+
+    // producers and consumers hammer different counters, keep them on different lines
+    alignas(64) std::atomic<size_t> enqueuePos;
+    alignas(64) std::atomic<size_t> dequeuePos;
+};
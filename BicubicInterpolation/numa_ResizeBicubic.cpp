@@ -0,0 +1,275 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <cstring>
+#include <omp.h>
+#include "resizeCore.h"
+#include "threadAffinity.h"
+#include "numa_ResizeBicubic.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// libnuma is opt-in: define USE_LIBNUMA and link -lnuma. Without it NUMA_BIND
+// falls back to parallel first touch.
+#if defined(USE_LIBNUMA) && defined(__linux__)
+#include <numa.h>
+#endif
+
+using namespace std;
+
+// pages placed per work item, so the touch pass does not take a counter per page
+static const size_t pagesPerChunk = 16;
+
+// copy rows handed out per work item
+static const int rowsPerChunk = 8;
+
+static size_t pageBytes() {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+#else
+    return (size_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+// Runs body(node, item) for items [0, counts[node]) of every node. A node's
+// threads take its items first and then help the others, so every item runs
+// even when OpenMP hands out fewer threads than the team asks for.
+template<typename Body>
+static void forEachNodeItem(const NumaTeam& team, const vector<int>& counts, Body body) {
+    int nodes = team.nodes();
+    unique_ptr<atomic<int>[]> next(new atomic<int>[nodes]);
+    for (int i = 0; i < nodes; ++i) {
+        next[i] = 0;
+    }
+
+    #pragma omp parallel num_threads(team.threads())
+    {
+        int t = omp_get_thread_num();
+        bool pinned = team.cpu[t] >= 0 && pinCurrentThread(team.cpu[t]);
+        int home = team.node[t];
+
+        for (int k = 0; k < nodes; ++k) {
+            int node = (home + k) % nodes;
+            for (int item = next[node]++; item < counts[node]; item = next[node]++) {
+                body(node, item);
+            }
+        }
+
+        if (pinned) {
+            unpinCurrentThread();
+        }
+    }
+}
+
+NumaTeam numa_MakeTeam(int threads) {
+    if (threads <= 0) {
+        threads = omp_get_max_threads();
+    }
+
+    map<int, vector<LogicalCpu>> nodeCpus;
+    for (const LogicalCpu& cpu : detectCpuTopology()) {
+        nodeCpus[cpu.node].push_back(cpu);
+    }
+
+    NumaTeam team;
+    if (nodeCpus.empty()) {
+        // no topology: one node, threads left to the OS
+        team.nodeIds.push_back(0);
+        team.nodeThreads.push_back(threads);
+        team.cpu.assign(threads, -1);
+        team.node.assign(threads, 0);
+        return team;
+    }
+
+    int totalCpus = 0;
+    for (const auto& entry : nodeCpus) {
+        totalCpus += (int)entry.second.size();
+    }
+
+    // node i gets threads [threads * cpusBefore / total, threads * cpusThrough / total)
+    int cpusBefore = 0;
+    for (const auto& entry : nodeCpus) {
+        vector<int> order = affinityOrder(entry.second, AFFINITY_SCATTER);
+        int first = (int)((long long)threads * cpusBefore / totalCpus);
+        cpusBefore += (int)entry.second.size();
+        int last = (int)((long long)threads * cpusBefore / totalCpus);
+
+        int index = team.nodes();
+        team.nodeIds.push_back(entry.first);
+        team.nodeThreads.push_back(last - first);
+        for (int i = 0; i < last - first; ++i) {
+            team.cpu.push_back(order[i % order.size()]);
+            team.node.push_back(index);
+        }
+    }
+    return team;
+}
+
+vector<int> numa_RowBands(const NumaTeam& team, int rows) {
+    vector<int> bands(1, 0);
+    int threadsBefore = 0;
+    for (int threads : team.nodeThreads) {
+        threadsBefore += threads;
+        bands.push_back((int)((long long)rows * threadsBefore / max(team.threads(), 1)));
+    }
+    bands.back() = rows;
+    return bands;
+}
+
+vector<int> numa_SourceBands(const ResizePlan& plan, const vector<int>& dstBands) {
+    vector<int> bands;
+    for (int row : dstBands) {
+        bands.push_back((int)min((long long)row * plan.srcHeight / plan.dstHeight, (long long)plan.srcHeight));
+    }
+    bands.back() = plan.srcHeight;
+    return bands;
+}
+
+bool numa_BindAvailable() {
+#if defined(USE_LIBNUMA) && defined(__linux__)
+    static const bool available = numa_available() >= 0;
+    return available;
+#else
+    return false;
+#endif
+}
+
+NumaBuffer::NumaBuffer(size_t bytes) : memory(nullptr), bytes(bytes) {
+    size_t length = max(bytes, (size_t)1);
+#if defined(_WIN32)
+    // committed pages get their frame on first touch, as with mmap
+    memory = (unsigned char*)VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!memory) {
+        throw bad_alloc();
+    }
+#else
+    void* mapped = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) {
+        throw bad_alloc();
+    }
+    memory = (unsigned char*)mapped;
+#endif
+}
+
+NumaBuffer::~NumaBuffer() {
+#if defined(_WIN32)
+    VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    munmap(memory, max(bytes, (size_t)1));
+#endif
+}
+
+void NumaBuffer::place(const NumaTeam& team, const vector<int>& bands, size_t rowBytes, NumaPlacement placement) {
+    size_t page = pageBytes();
+    int nodes = team.nodes();
+
+    // whole pages per node, band starts rounded down
+    vector<size_t> edges(nodes + 1);
+    for (int i = 0; i < nodes; ++i) {
+        edges[i] = min((size_t)bands[i] * rowBytes / page * page, bytes);
+    }
+    edges[0] = 0;
+    edges[nodes] = bytes;
+
+#if defined(USE_LIBNUMA) && defined(__linux__)
+    if (placement == NUMA_BIND && numa_BindAvailable()) {
+        for (int i = 0; i < nodes; ++i) {
+            if (edges[i + 1] > edges[i]) {
+                numa_tonode_memory(memory + edges[i], edges[i + 1] - edges[i], team.nodeIds[i]);
+            }
+        }
+    }
+#else
+    (void)placement;
+#endif
+
+    // bound or not, fault every page in now so the resize does not pay for it
+    vector<int> chunks(nodes);
+    for (int i = 0; i < nodes; ++i) {
+        size_t pages = (edges[i + 1] - edges[i] + page - 1) / page;
+        chunks[i] = (int)((pages + pagesPerChunk - 1) / pagesPerChunk);
+    }
+    unsigned char* base = memory;
+    forEachNodeItem(team, chunks, [&](int node, int chunk) {
+        size_t begin = edges[node] + (size_t)chunk * pagesPerChunk * page;
+        size_t end = min(begin + pagesPerChunk * page, edges[node + 1]);
+        for (size_t offset = begin; offset < end; offset += page) {
+            base[offset] = 0;
+        }
+    });
+}
+
+void numa_CopyRows(const NumaTeam& team, const vector<int>& bands, const unsigned char* src, unsigned char* dst, size_t rowBytes) {
+    vector<int> chunks(team.nodes());
+    for (int i = 0; i < team.nodes(); ++i) {
+        chunks[i] = (bands[i + 1] - bands[i] + rowsPerChunk - 1) / rowsPerChunk;
+    }
+    forEachNodeItem(team, chunks, [&](int node, int chunk) {
+        int y0 = bands[node] + chunk * rowsPerChunk;
+        int y1 = min(y0 + rowsPerChunk, bands[node + 1]);
+        memcpy(&dst[(size_t)y0 * rowBytes], &src[(size_t)y0 * rowBytes], (size_t)(y1 - y0) * rowBytes);
+    });
+}
+
+void numa_ResizeBicubic(const ResizePlan& plan, const NumaTeam& team, const ImageView& src, const ImageView& dst,
+    int tileWidth, int tileHeight) {
+    int channels = src.channels;
+    if (tileWidth <= 0 || tileHeight <= 0) {
+        planTileSize(plan, channels, team.threads(), tileWidth, tileHeight);
+    }
+
+    int dstWidth = plan.dstWidth;
+    int tilesX = (dstWidth + tileWidth - 1) / tileWidth;
+    vector<int> bands = numa_RowBands(team, plan.dstHeight);
+
+    // tiles never cross a band edge, so each tile's output pages sit on one node
+    vector<int> tiles(team.nodes());
+    for (int i = 0; i < team.nodes(); ++i) {
+        tiles[i] = tilesX * ((bands[i + 1] - bands[i] + tileHeight - 1) / tileHeight);
+    }
+
+    forEachNodeItem(team, tiles, [&](int node, int tile) {
+        int x0 = (tile % tilesX) * tileWidth;
+        int y0 = bands[node] + (tile / tilesX) * tileHeight;
+        bicubicTileDispatch<unsigned char>(plan, src.data, src.pitch, channels, dst.data, dst.pitch, x0, y0,
+            min(x0 + tileWidth, dstWidth), min(y0 + tileHeight, bands[node + 1]));
+    });
+}
+
+void numa_ResizeBicubic(const ResizePlan& plan, const NumaTeam& team, const unsigned char* src, int channels, unsigned char* dst,
+    int tileWidth, int tileHeight) {
+    numa_ResizeBicubic(plan, team, ImageView((unsigned char*)src, plan.srcWidth, plan.srcHeight, channels),
+        ImageView(dst, plan.dstWidth, plan.dstHeight, channels), tileWidth, tileHeight);
+}
+
+// the topology is read from /sys on every numa_MakeTeam, so keep the team
+// until the OpenMP thread count changes
+static NumaTeam defaultTeam() {
+    static mutex teamMutex;
+    static NumaTeam cachedTeam;
+    lock_guard<mutex> lock(teamMutex);
+    if (cachedTeam.threads() != omp_get_max_threads()) {
+        cachedTeam = numa_MakeTeam();
+    }
+    return cachedTeam;
+}
+
+void numa_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels,
+    unsigned char* dst, int dstWidth, int dstHeight) {
+    numa_ResizeBicubic(*getResizePlan(srcWidth, srcHeight, dstWidth, dstHeight), defaultTeam(), src, channels, dst);
+}
+
+void numa_ResizeBicubic(const ImageView& src, const ImageView& dst) {
+    numa_ResizeBicubic(*getResizePlan(src.width, src.height, dst.width, dst.height), defaultTeam(), src, dst);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "resizePlan.h"
+#include "imageView.h"
+
+// How a NumaBuffer's pages are put on nodes
+enum NumaPlacement {
+    NUMA_FIRST_TOUCH,  // each node's pinned threads write their band first
+    NUMA_BIND          // libnuma binds each band to its node (first touch when libnuma is missing)
+};
+
+// OpenMP team laid out over the NUMA nodes: threads are split across nodes in
+// proportion to each node's CPUs and pinned one per core first within their
+// node. Node indices run 0..nodes()-1; nodeIds holds the OS node numbers.
+struct NumaTeam {
+    std::vector<int> cpu;          // thread -> OS processor, -1 leaves it unpinned
+    std::vector<int> node;         // thread -> node index
+    std::vector<int> nodeThreads;  // node index -> threads
+    std::vector<int> nodeIds;      // node index -> OS node number
+
+    int threads() const { return (int)cpu.size(); }
+    int nodes() const { return (int)nodeIds.size(); }
+};
+
+// threads == 0 uses omp_get_max_threads
+NumaTeam numa_MakeTeam(int threads = 0);
+
+// Row band of each node: node i owns rows [bands[i], bands[i + 1]), sized by
+// its share of the team's threads. Nodes without threads get an empty band.
+std::vector<int> numa_RowBands(const NumaTeam& team, int rows);
+
+// Source rows matching output bands: each node's source band is the part of
+// the source its output band mostly reads (halo rows go to one neighbour)
+std::vector<int> numa_SourceBands(const ResizePlan& plan, const std::vector<int>& dstBands);
+
+// True when NUMA_BIND really binds (built with USE_LIBNUMA and the kernel supports it)
+bool numa_BindAvailable();
+
+// Page-aligned buffer that is reserved without touching its pages, so where
+// they land is decided by place rather than by whichever thread writes first
+class NumaBuffer {
+public:
+    explicit NumaBuffer(size_t bytes);
+    ~NumaBuffer();
+
+    NumaBuffer(const NumaBuffer&) = delete;
+    NumaBuffer& operator=(const NumaBuffer&) = delete;
+
+    unsigned char* data() const { return memory; }
+    size_t size() const { return bytes; }
+
+    // Puts rows [bands[i], bands[i + 1]) of rowBytes each on node i. Band
+    // edges are rounded down to whole pages, so a page shared by two bands
+    // goes to the later one. Every page is touched before returning.
+    void place(const NumaTeam& team, const std::vector<int>& bands, size_t rowBytes, NumaPlacement placement);
+
+private:
+    unsigned char* memory;
+    size_t bytes;
+};
+
+// Copies rows [bands[i], bands[i + 1]) from src to dst on node i's threads
+void numa_CopyRows(const NumaTeam& team, const std::vector<int>& bands, const unsigned char* src, unsigned char* dst, size_t rowBytes);
+
+// Tiled 2D resize where node i's threads work through the tiles of output
+// band i and only then help other nodes, so with placed buffers nearly every
+// read and write stays on the local node. Threads are pinned for the call.
+void numa_ResizeBicubic(const ResizePlan& plan, const NumaTeam& team, const unsigned char* src, int channels, unsigned char* dst,
+    int tileWidth = 0, int tileHeight = 0);
+
+// Strided source and destination; the plan sizes are the view sizes
+void numa_ResizeBicubic(const ResizePlan& plan, const NumaTeam& team, const ImageView& src, const ImageView& dst,
+    int tileWidth = 0, int tileHeight = 0);
+
+// resizeFunc-compatible entry points: default team, buffers left where they are
+void numa_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+void numa_ResizeBicubic(const ImageView& src, const ImageView& dst);
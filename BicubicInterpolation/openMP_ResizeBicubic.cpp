@@ -1,48 +1,90 @@
 #include <iostream>
+#include <algorithm>
 #include <omp.h>
-#include "bicubicKernel.h"
+#include "resizeCore.h"
+#include "openMP_ResizeBicubic.h"
 
 using namespace std;
 
+template<int Channels>
+static void openMP_ResizeFlatChannels(const ResizePlan& plan, unsigned char* src, int channels, unsigned char* dst) {
+    int dstWidth = plan.dstWidth;
+
+    // compute total number of pixels, 64-bit so gigapixel outputs do not wrap
+    ptrdiff_t totalPixels = (ptrdiff_t)dstWidth * plan.dstHeight;
+
+    // per-pixel results live in bicubicPixel2D, sized by Channels, so there is
+    // no shared buffer to race on and no fixed channel limit
+    #pragma omp parallel for
+    for (ptrdiff_t idx = 0; idx < totalPixels; ++idx) {
+        int y = (int)(idx / dstWidth); // convert linear index to 2D coordinates (y)
+        int x = (int)(idx % dstWidth); // convert linear index to 2D coordinates (x)
+
+        // write the computed result to the output image
+        bicubicPixel2D<Channels, unsigned char>(plan, src, (size_t)plan.srcWidth * channels, channels, &dst[(size_t)idx * channels], x, y);
+    }
+}
+
+// Pitches are in Pixels, so one body serves 8-bit, 16-bit and float images
+template<typename Pixel>
+static void openMP_ResizeTiles(const ResizePlan& plan, const Pixel* src, size_t srcPitch, int channels, Pixel* dst, size_t dstPitch,
+    int tileWidth, int tileHeight) {
+    if (tileWidth <= 0 || tileHeight <= 0) {
+        planTileSize(plan, channels, omp_get_max_threads(), tileWidth, tileHeight);
+    }
+
+    int dstWidth = plan.dstWidth;
+    int tilesX = (dstWidth + tileWidth - 1) / tileWidth;
+    int tilesY = (plan.dstHeight + tileHeight - 1) / tileHeight;
+    int totalTiles = tilesX * tilesY;
+
+    // tiles cost about the same except at the borders, so dynamic with chunk 1
+    // mainly absorbs the slower clamped edge tiles
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int tile = 0; tile < totalTiles; ++tile) {
+        int x0 = (tile % tilesX) * tileWidth;
+        int y0 = (tile / tilesX) * tileHeight;
+        bicubicTileDispatch<Pixel>(plan, src, srcPitch, channels, dst, dstPitch, x0, y0,
+            min(x0 + tileWidth, dstWidth), min(y0 + tileHeight, plan.dstHeight));
+    }
+}
+
+void openMP_ResizeBicubic(const ResizePlan& plan, const ImageView& src, const ImageView& dst, int tileWidth, int tileHeight) {
+    openMP_ResizeTiles<unsigned char>(plan, src.data, src.pitch, src.channels, dst.data, dst.pitch, tileWidth, tileHeight);
+}
+
+void openMP_ResizeBicubic(const ResizePlan& plan, const unsigned short* src, int channels, unsigned short* dst, int tileWidth, int tileHeight) {
+    openMP_ResizeTiles<unsigned short>(plan, src, (size_t)plan.srcWidth * channels, channels, dst, (size_t)plan.dstWidth * channels,
+        tileWidth, tileHeight);
+}
+
+void openMP_ResizeBicubic(const ResizePlan& plan, const float* src, int channels, float* dst, int tileWidth, int tileHeight) {
+    openMP_ResizeTiles<float>(plan, src, (size_t)plan.srcWidth * channels, channels, dst, (size_t)plan.dstWidth * channels,
+        tileWidth, tileHeight);
+}
+
+void openMP_ResizeBicubic(const ResizePlan& plan, unsigned char* src, int channels, unsigned char* dst, int tileWidth, int tileHeight) {
+    openMP_ResizeBicubic(plan, ImageView(src, plan.srcWidth, plan.srcHeight, channels), ImageView(dst, plan.dstWidth, plan.dstHeight, channels),
+        tileWidth, tileHeight);
+}
+
+void openMP_ResizeBicubic(const ImageView& src, const ImageView& dst) {
+    openMP_ResizeBicubic(*getResizePlan(src.width, src.height, dst.width, dst.height), src, dst);
+}
+
 void openMP_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels,
     unsigned char* dst, int dstWidth, int dstHeight) {
-    float scaleX = (float)srcWidth / dstWidth;
-    float scaleY = (float)srcHeight / dstHeight;
-
-    // compute total number of pixels
-    int totalPixels = dstWidth * dstHeight;
-
-    #pragma omp parallel
-    {
-        // to avoid race condition
-        float localResult[4]; // 4 channels max (RGBA)
-
-        #pragma omp for
-        for (int idx = 0; idx < totalPixels; ++idx) {
-            int y = idx / dstWidth; // convert linear index to 2D coordinates (y)
-            int x = idx % dstWidth; // convert linear index to 2D coordinates (x)
-
-            for (int c = 0; c < channels; ++c) {
-                float srcX = x * scaleX;
-                float srcY = y * scaleY;
-                int x1 = (int)srcX;
-                int y1 = (int)srcY;
-
-                localResult[c] = 0.0f; // reset local result
-
-                // sum result using thread-local variable
-                for (int m = -1; m <= 2; ++m) {
-                    for (int n = -1; n <= 2; ++n) {
-                        float weight = bicubicKernel(srcX - (x1 + n)) * bicubicKernel(srcY - (y1 + m));
-                        float pixelValue = getPixelValue(src, srcWidth, srcHeight, channels, x1 + n, y1 + m, c);
-                        localResult[c] += pixelValue * weight;
-                    }
-                }
-
-                // write the computed result to the output image
-                dst[(y * dstWidth + x) * channels + c] = min(max((int)localResult[c], 0), 255);
-            }
-        }
-    }
+    openMP_ResizeBicubic(*getResizePlan(srcWidth, srcHeight, dstWidth, dstHeight), src, channels, dst);
 }
 
+void openMP_ResizeBicubicFlat(unsigned char* src, int srcWidth, int srcHeight, int channels,
+    unsigned char* dst, int dstWidth, int dstHeight) {
+    const ResizePlan& plan = *getResizePlan(srcWidth, srcHeight, dstWidth, dstHeight);
+    switch (channels) {
+    case 1: openMP_ResizeFlatChannels<1>(plan, src, channels, dst); break;
+    case 2: openMP_ResizeFlatChannels<2>(plan, src, channels, dst); break;
+    case 3: openMP_ResizeFlatChannels<3>(plan, src, channels, dst); break;
+    case 4: openMP_ResizeFlatChannels<4>(plan, src, channels, dst); break;
+    default: openMP_ResizeFlatChannels<0>(plan, src, channels, dst); break;
+    }
+}
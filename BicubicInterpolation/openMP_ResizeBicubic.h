@@ -1,2 +1,25 @@
 #pragma once
+#include "resizePlan.h"
+#include "imageView.h"
 void openMP_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+
+// Output is split into 2D tiles handed out with a dynamic schedule. A tile
+// size of 0 picks one with planTileSize.
+void openMP_ResizeBicubic(const ResizePlan& plan, unsigned char* src, int channels, unsigned char* dst, int tileWidth = 0, int tileHeight = 0);
+
+// Strided source and destination; the plan sizes are the view sizes
+void openMP_ResizeBicubic(const ResizePlan& plan, const ImageView& src, const ImageView& dst, int tileWidth = 0, int tileHeight = 0);
+void openMP_ResizeBicubic(const ImageView& src, const ImageView& dst);
+
+// 16-bit and float images, packed; same tiling, results saturate to the type's range
+void openMP_ResizeBicubic(const ResizePlan& plan, const unsigned short* src, int channels, unsigned short* dst, int tileWidth = 0, int tileHeight = 0);
+void openMP_ResizeBicubic(const ResizePlan& plan, const float* src, int channels, float* dst, int tileWidth = 0, int tileHeight = 0);
+
+// Previous flat per-pixel loop (static schedule), kept as the tiling baseline
+void openMP_ResizeBicubicFlat(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+
+// resizeFunc-compatible entry point for any plan kernel, e.g. openMP_Resize<Lanczos3Kernel>
+template<typename Kernel>
+void openMP_Resize(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight) {
+    openMP_ResizeBicubic(*getResizePlan<Kernel>(srcWidth, srcHeight, dstWidth, dstHeight), src, channels, dst);
+}
@@ -0,0 +1,171 @@
+#include <iostream>
+#include <algorithm>
+#include <future>
+#include <vector>
+#include <omp.h>
+#include "resizeCore.h"
+#include "tiledImage.h"
+#include "outOfCore_ResizeBicubic.h"
+
+using namespace std;
+
+// Output tiles [tx0, tx1) of tile row ty and the source tiles they read
+struct OutOfCoreBlock {
+    int ty, tx0, tx1;
+    int srcTx0, srcTx1, srcTy0, srcTy1;
+};
+
+// Source tiles a and b both need
+static size_t sharedTiles(const OutOfCoreBlock& a, const OutOfCoreBlock& b) {
+    int columns = min(a.srcTx1, b.srcTx1) - max(a.srcTx0, b.srcTx0);
+    int rows = min(a.srcTy1, b.srcTy1) - max(a.srcTy0, b.srcTy0);
+    return columns > 0 && rows > 0 ? (size_t)columns * rows : 0;
+}
+
+// Source tiles of a that b does not also need
+static void releaseUnshared(const TiledImage& src, const OutOfCoreBlock& a, const OutOfCoreBlock* b) {
+    for (int ty = a.srcTy0; ty < a.srcTy1; ++ty) {
+        if (!b || ty < b->srcTy0 || ty >= b->srcTy1) {
+            src.releaseTiles(a.srcTx0, ty, a.srcTx1, ty + 1);
+            continue;
+        }
+        src.releaseTiles(a.srcTx0, ty, min(a.srcTx1, b->srcTx0), ty + 1);
+        src.releaseTiles(max(a.srcTx0, b->srcTx1), ty, a.srcTx1, ty + 1);
+    }
+}
+
+bool outOfCore_ResizeBicubic(const string& srcPath, const string& dstPath, int dstWidth, int dstHeight,
+    const OutOfCoreOptions& options, OutOfCoreStats* stats) {
+    double start_time = omp_get_wtime();
+
+    // an empty output has no tiles, and so no blocks to prefetch
+    if (dstWidth <= 0 || dstHeight <= 0 || options.tileWidth < 0 || options.tileHeight < 0) {
+        cerr << "Invalid output size " << dstWidth << "x" << dstHeight << " or tile size " << options.tileWidth << "x"
+            << options.tileHeight << endl;
+        return false;
+    }
+
+    TiledImage src;
+    if (!src.open(srcPath)) {
+        cerr << "Failed to open tiled image: " << srcPath << endl;
+        return false;
+    }
+    int channels = src.channels();
+    int tileWidth = options.tileWidth > 0 ? options.tileWidth : src.tileWidth();
+    int tileHeight = options.tileHeight > 0 ? options.tileHeight : src.tileHeight();
+
+    TiledImage dst;
+    if (!dst.create(dstPath, dstWidth, dstHeight, channels, tileWidth, tileHeight)) {
+        cerr << "Failed to create tiled image: " << dstPath << endl;
+        return false;
+    }
+
+    shared_ptr<const ResizePlan> planRef = getResizePlan(src.width(), src.height(), dstWidth, dstHeight);
+    const ResizePlan& plan = *planRef;
+
+    // source tile span, and source window size, of every output tile column and row
+    vector<int> colFirst(dst.tilesX()), colEnd(dst.tilesX()), rowFirst(dst.tilesY()), rowEnd(dst.tilesY());
+    int windowWidth = 0, windowHeight = 0;
+    for (int tx = 0; tx < dst.tilesX(); ++tx) {
+        int first, end;
+        planSourceColumns(plan, tx * tileWidth, min((tx + 1) * tileWidth, dstWidth), first, end);
+        colFirst[tx] = first / src.tileWidth();
+        colEnd[tx] = end > first ? (end - 1) / src.tileWidth() + 1 : colFirst[tx];
+        windowWidth = max(windowWidth, end - first);
+    }
+    for (int ty = 0; ty < dst.tilesY(); ++ty) {
+        int first, end;
+        planSourceRows(plan, ty * tileHeight, min((ty + 1) * tileHeight, dstHeight), first, end);
+        rowFirst[ty] = first / src.tileHeight();
+        rowEnd[ty] = end > first ? (end - 1) / src.tileHeight() + 1 : rowFirst[ty];
+        windowHeight = max(windowHeight, end - first);
+    }
+
+    int threads = omp_get_max_threads();
+    size_t windowBytes = (size_t)windowWidth * windowHeight * channels;
+    size_t scratchBytes = windowBytes * threads;
+
+    auto blockBytes = [&](int ty, int tx0, int tx1) {
+        size_t srcTiles = (size_t)(colEnd[tx1 - 1] - colFirst[tx0]) * (rowEnd[ty] - rowFirst[ty]);
+        return srcTiles * src.tileBytes() + (size_t)(tx1 - tx0) * dst.tileBytes();
+    };
+
+    // one block computes while the next is prefetched, so each gets half of what scratch leaves
+    size_t blockBudget = options.memoryBudget > scratchBytes ? (options.memoryBudget - scratchBytes) / 2 : 0;
+    vector<OutOfCoreBlock> blocks;
+    bool overBudget = false;
+    for (int ty = 0; ty < dst.tilesY(); ++ty) {
+        for (int tx0 = 0; tx0 < dst.tilesX();) {
+            int tx1 = tx0 + 1;
+            while (tx1 < dst.tilesX() && blockBytes(ty, tx0, tx1 + 1) <= blockBudget) {
+                ++tx1;
+            }
+            overBudget = overBudget || blockBytes(ty, tx0, tx1) > blockBudget;
+            blocks.push_back(OutOfCoreBlock{ ty, tx0, tx1, colFirst[tx0], colEnd[tx1 - 1], rowFirst[ty], rowEnd[ty] });
+            tx0 = tx1;
+        }
+    }
+
+    size_t plannedPeak = 0, fetches = 0;
+    for (size_t k = 0; k < blocks.size(); ++k) {
+        const OutOfCoreBlock& b = blocks[k];
+        size_t bytes = blockBytes(b.ty, b.tx0, b.tx1);
+        if (k + 1 < blocks.size()) {
+            bytes += blockBytes(blocks[k + 1].ty, blocks[k + 1].tx0, blocks[k + 1].tx1);
+        }
+        plannedPeak = max(plannedPeak, bytes + scratchBytes);
+        // tiles shared with the block before are still resident
+        fetches += (size_t)(b.srcTx1 - b.srcTx0) * (b.srcTy1 - b.srcTy0) - (k > 0 ? sharedTiles(blocks[k - 1], b) : 0);
+    }
+
+    auto prefetch = [&src](const OutOfCoreBlock& b) {
+        src.prefetchTiles(b.srcTx0, b.srcTy0, b.srcTx1, b.srcTy1);
+    };
+
+    vector<vector<unsigned char>> windows(threads, vector<unsigned char>(windowBytes));
+    double waitSeconds = 0.0;
+    future<void> pending = async(launch::async, prefetch, blocks[0]);
+
+    for (size_t k = 0; k < blocks.size(); ++k) {
+        const OutOfCoreBlock& block = blocks[k];
+        double wait_start = omp_get_wtime();
+        pending.get();
+        waitSeconds += omp_get_wtime() - wait_start;
+
+        const OutOfCoreBlock* next = k + 1 < blocks.size() ? &blocks[k + 1] : nullptr;
+        if (next) {
+            pending = async(launch::async, prefetch, *next);
+        }
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int tx = block.tx0; tx < block.tx1; ++tx) {
+            ImageView out = dst.tile(tx, block.ty);
+            int x0 = tx * tileWidth, y0 = block.ty * tileHeight;
+            int srcX0, srcY0;
+            ResizePlan window = windowResizePlan(plan, x0, y0, x0 + out.width, y0 + out.height, srcX0, srcY0);
+
+            ImageView in(windows[omp_get_thread_num()].data(), window.srcWidth, window.srcHeight, channels);
+            src.readRegion(srcX0, srcY0, in);
+            bicubicTileDispatch<unsigned char>(window, in.data, in.pitch, channels, out.data, out.pitch, 0, 0, out.width, out.height);
+        }
+
+        releaseUnshared(src, block, next);
+        dst.releaseTiles(block.tx0, block.ty, block.tx1, block.ty + 1);
+    }
+
+    bool flushed = dst.flush();
+    if (!flushed) {
+        cerr << "Failed to write tiled image: " << dstPath << endl;
+    }
+
+    if (stats) {
+        stats->blocks = (int)blocks.size();
+        stats->sourceTiles = (size_t)src.tilesX() * src.tilesY();
+        stats->sourceTileFetches = fetches;
+        stats->plannedPeakBytes = plannedPeak;
+        stats->overBudget = overBudget;
+        stats->prefetchWaitSeconds = waitSeconds;
+        stats->seconds = omp_get_wtime() - start_time;
+    }
+    return flushed;
+}
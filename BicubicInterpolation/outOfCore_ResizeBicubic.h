@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+struct OutOfCoreOptions {
+    size_t memoryBudget;        // bytes of source tiles, output tiles and scratch resident at once
+    int tileWidth, tileHeight;  // output file tiles, 0 takes the source file's
+
+    OutOfCoreOptions() : memoryBudget((size_t)256 << 20), tileWidth(0), tileHeight(0) {}
+};
+
+struct OutOfCoreStats {
+    int blocks;                // groups of output tiles run between prefetches
+    size_t sourceTiles;        // tiles in the source file
+    size_t sourceTileFetches;  // tiles read in, counted again when dropped and needed later
+    size_t plannedPeakBytes;   // worst-case resident tiles and scratch, two blocks at a time
+    bool overBudget;           // even a one-tile block did not fit the budget
+    double prefetchWaitSeconds;
+    double seconds;
+};
+
+// Resizes a tiled source file (see TiledImage) into a new tiled file without
+// ever holding either image. Output tiles are grouped into blocks along each
+// tile row, as wide as the budget allows; each output tile copies just the
+// source window it reads, bicubic halo included, out of the mapped source
+// tiles and is filtered straight into its mapped output tile. While one block
+// computes, a background thread faults in the next block's source tiles, and
+// finished tiles are dropped from memory (output written back first), so the
+// resident set stays near two blocks whatever the image size. Output matches
+// openMP_ResizeBicubic on the same image exactly. False, with nothing
+// written, for a non-positive output size or a negative tile size.
+bool outOfCore_ResizeBicubic(const std::string& srcPath, const std::string& dstPath, int dstWidth, int dstHeight,
+    const OutOfCoreOptions& options = OutOfCoreOptions(), OutOfCoreStats* stats = nullptr);
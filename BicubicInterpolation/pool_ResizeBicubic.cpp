@@ -0,0 +1,77 @@
+#include <iostream>
+#include <algorithm>
+#include "resizeCore.h"
+#include "threadPool.h"
+#include "pool_ResizeBicubic.h"
+
+using namespace std;
+
+void pool_ResizeBicubic(const ResizePlan& plan, const ImageView& src, const ImageView& dst, int tileWidth, int tileHeight) {
+    int channels = src.channels;
+    ThreadPool& pool = ThreadPool::instance();
+    if (tileWidth <= 0 || tileHeight <= 0) {
+        planTileSize(plan, channels, pool.workerCount() + 1, tileWidth, tileHeight);
+    }
+
+    int dstWidth = plan.dstWidth;
+    int tilesX = (dstWidth + tileWidth - 1) / tileWidth;
+    int tilesY = (plan.dstHeight + tileHeight - 1) / tileHeight;
+
+    pool.parallelFor(tilesX * tilesY, [&](int tile) {
+        int x0 = (tile % tilesX) * tileWidth;
+        int y0 = (tile / tilesX) * tileHeight;
+        bicubicTileDispatch<unsigned char>(plan, src.data, src.pitch, channels, dst.data, dst.pitch, x0, y0,
+            min(x0 + tileWidth, dstWidth), min(y0 + tileHeight, plan.dstHeight));
+    });
+}
+
+void pool_ResizeBicubic(const ResizePlan& plan, unsigned char* src, int channels, unsigned char* dst, int tileWidth, int tileHeight) {
+    pool_ResizeBicubic(plan, ImageView(src, plan.srcWidth, plan.srcHeight, channels), ImageView(dst, plan.dstWidth, plan.dstHeight, channels),
+        tileWidth, tileHeight);
+}
+
+void pool_ResizeBicubic(const ImageView& src, const ImageView& dst) {
+    pool_ResizeBicubic(*getResizePlan(src.width, src.height, dst.width, dst.height), src, dst);
+}
+
+void pool_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels,
+    unsigned char* dst, int dstWidth, int dstHeight) {
+    pool_ResizeBicubic(*getResizePlan(srcWidth, srcHeight, dstWidth, dstHeight), src, channels, dst);
+}
+
+void pool_SimpleResize(unsigned char* src, int srcWidth, int srcHeight, int channels,
+    unsigned char* dst, int dstWidth, int dstHeight) {
+    pool_SimpleResize(ImageView(src, srcWidth, srcHeight, channels), ImageView(dst, dstWidth, dstHeight, channels));
+}
+
+void pool_SimpleResize(const ImageView& src, const ImageView& dst) {
+    int srcHeight = src.height, dstWidth = dst.width, dstHeight = dst.height;
+    float scaleX = (float)src.width / dstWidth;
+    float scaleY = (float)srcHeight / dstHeight;
+
+    // bands of rows, a few per thread
+    ThreadPool& pool = ThreadPool::instance();
+    int bandHeight = max(1, dstHeight / (4 * (pool.workerCount() + 1)));
+    int bands = (dstHeight + bandHeight - 1) / bandHeight;
+
+    pool.parallelFor(bands, [=](int band) {
+        // dst stores are unsigned char and may alias the closure, so work on locals
+        const unsigned char* in = src.data;
+        unsigned char* out = dst.data;
+        size_t inPitch = src.pitch, outPitch = dst.pitch;
+        int outWidth = dstWidth, ch = src.channels;
+        float sx = scaleX, sy = scaleY;
+
+        int y1 = min((band + 1) * bandHeight, dstHeight);
+        for (int y = band * bandHeight; y < y1; ++y) {
+            for (int x = 0; x < outWidth; ++x) {
+                int srcX = (int)(x * sx);
+                int srcY = (int)(y * sy);
+
+                for (int c = 0; c < ch; ++c) {
+                    out[y * outPitch + (size_t)x * ch + c] = in[srcY * inPitch + (size_t)srcX * ch + c];
+                }
+            }
+        }
+    });
+}
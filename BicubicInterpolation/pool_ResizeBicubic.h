@@ -0,0 +1,15 @@
+#pragma once
+#include "resizePlan.h"
+#include "imageView.h"
+
+// Tiled 2D bicubic and nearest-neighbour resizes run on the persistent
+// ThreadPool instead of an OpenMP region. Meant for many small images, where
+// starting a parallel region per call costs as much as the resize itself.
+void pool_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+void pool_ResizeBicubic(const ResizePlan& plan, unsigned char* src, int channels, unsigned char* dst, int tileWidth = 0, int tileHeight = 0);
+void pool_SimpleResize(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+
+// Strided source and destination; the plan sizes are the view sizes
+void pool_ResizeBicubic(const ResizePlan& plan, const ImageView& src, const ImageView& dst, int tileWidth = 0, int tileHeight = 0);
+void pool_ResizeBicubic(const ImageView& src, const ImageView& dst);
+void pool_SimpleResize(const ImageView& src, const ImageView& dst);
@@ -0,0 +1,68 @@
+#include <vector>
+#include <omp.h>
+#include "pyramid_ResizeBicubic.h"
+#include "separable_ResizeBicubic.h"
+#include "simd_ResizeBicubic.h"
+#include "simdKernels.h"
+#include "bufferArena.h"
+
+using namespace std;
+
+void boxReduceRow_Scalar(const unsigned char* row0, const unsigned char* row1, unsigned char* dstRow, int dstWidth, int channels) {
+    boxReducePixels(row0, row1, dstRow, dstWidth, channels, 0);
+}
+
+// Number of halvings before the remaining ratio is under 2x on either axis;
+// each halving keeps the level at least as large as the target
+static int pyramidLevels(int srcWidth, int srcHeight, int dstWidth, int dstHeight) {
+    int levels = 0;
+    while (srcWidth >= 2 * dstWidth && srcHeight >= 2 * dstHeight) {
+        srcWidth /= 2;
+        srcHeight /= 2;
+        ++levels;
+    }
+    return levels;
+}
+
+size_t pyramid_ScratchBytes(int srcWidth, int srcHeight, int channels, int dstWidth, int dstHeight) {
+    int levels = pyramidLevels(srcWidth, srcHeight, dstWidth, dstHeight);
+
+    // levels ping-pong between two slots sized for the first and second level
+    size_t level1 = levels >= 1 ? (size_t)(srcWidth / 2) * (srcHeight / 2) * channels : 0;
+    size_t level2 = levels >= 2 ? (size_t)(srcWidth / 4) * (srcHeight / 4) * channels : 0;
+
+    int lastHeight = srcHeight >> levels;
+    size_t intermediate = (size_t)lastHeight * dstWidth * channels * sizeof(float);
+    return level1 + level2 + intermediate;
+}
+
+void pyramid_ResizeBicubic(const ImageView& src, const ImageView& dst) {
+    int srcWidth = src.width, srcHeight = src.height, channels = src.channels;
+    int levels = pyramidLevels(srcWidth, srcHeight, dst.width, dst.height);
+    BoxReduceRowFunc boxReduceRow = simd_ActiveLevel() >= SIMD_AVX2 ? boxReduceRow_AVX2 : boxReduceRow_Scalar;
+
+    // level k goes to slot (k - 1) % 2; slot 0 holds the largest level
+    size_t level1 = levels >= 1 ? (size_t)(srcWidth / 2) * (srcHeight / 2) * channels : 0;
+    size_t level2 = levels >= 2 ? (size_t)(srcWidth / 4) * (srcHeight / 4) * channels : 0;
+    ArenaBuffer<unsigned char> arena(level1 + level2);
+    unsigned char* slots[2] = { arena.data(), arena.data() + level1 };
+
+    ImageView level = src;
+    for (int k = 0; k < levels; ++k) {
+        ImageView half(slots[k % 2], level.width / 2, level.height / 2, channels);
+
+        #pragma omp parallel for
+        for (int y = 0; y < half.height; ++y) {
+            boxReduceRow(level.row(2 * y), level.row(2 * y + 1), half.row(y), half.width, channels);
+        }
+
+        level = half;
+    }
+
+    separable_AntialiasResize<CatmullRomKernel>(level, dst);
+}
+
+void pyramid_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels,
+    unsigned char* dst, int dstWidth, int dstHeight) {
+    pyramid_ResizeBicubic(ImageView(src, srcWidth, srcHeight, channels), ImageView(dst, dstWidth, dstHeight, channels));
+}
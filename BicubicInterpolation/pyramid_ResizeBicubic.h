@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include "imageView.h"
+
+// Large downscales: halve the image with a 2x2 box filter while it is still
+// at least twice the target size, then finish the remaining <= 2x ratio with
+// the antialiased separable bicubic. Levels are borrowed from the shared
+// BufferArena, so repeated calls do not allocate.
+void pyramid_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+
+// Strided source and destination; only the first level reads the source
+void pyramid_ResizeBicubic(const ImageView& src, const ImageView& dst);
+
+// Bytes of pyramid scratch (levels plus the final pass's float intermediate)
+// used for one resize
+size_t pyramid_ScratchBytes(int srcWidth, int srcHeight, int channels, int dstWidth, int dstHeight);
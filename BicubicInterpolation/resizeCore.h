@@ -0,0 +1,217 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include "resizePlan.h"
+#include "bufferArena.h"
+
+// Templated resize bodies. Channels > 0 fixes the channel count at compile
+// time so the per-pixel channel loops unroll; Channels == 0 is the generic
+// runtime-channel fallback. Pixel is unsigned char, unsigned short or float.
+// srcPitch and dstPitch are row strides in Pixels, width * channels for
+// packed images and more for an ImageView region of a larger image.
+
+template<typename Pixel> struct PixelTraits;
+
+template<> struct PixelTraits<unsigned char> {
+    static unsigned char fromFloat(float value) { return value <= 0.0f ? 0 : value >= 255.0f ? 255 : (unsigned char)value; }
+};
+
+template<> struct PixelTraits<unsigned short> {
+    static unsigned short fromFloat(float value) { return value <= 0.0f ? 0 : value >= 65535.0f ? 65535 : (unsigned short)value; }
+};
+
+template<> struct PixelTraits<float> {
+    static float fromFloat(float value) { return value; }
+};
+
+// The BORDER_CONSTANT colour as a Pixel. Every backend converts it through
+// here, so an out-of-range colour is clamped the same way everywhere.
+template<typename Pixel>
+inline Pixel borderPixel(const ResizePlan& plan, int c) {
+    return PixelTraits<Pixel>::fromFloat(plan.borderValue(c));
+}
+
+// Source sample for a tap outside the interior. Index tables are already
+// mapped by the border mode; only BORDER_CONSTANT has a virtual pixel/row.
+template<typename Pixel>
+inline float borderSample(const ResizePlan& plan, const Pixel* src, size_t srcPitch, int channels, int xi, int yi, int c) {
+    if (xi == plan.srcWidth || yi == plan.srcHeight) {
+        return (float)borderPixel<Pixel>(plan, c);
+    }
+    return src[(size_t)yi * srcPitch + (size_t)xi * channels + c];
+}
+
+// One output pixel of the 16-tap 2D filter. Per channel the taps are summed
+// in the same order as serial_ResizeBicubic, so results match it exactly.
+// Interior pixels read the 4x4 block through row pointers with no index
+// lookups; border pixels go through the plan tables and borderSample.
+// Antialiased plans go through separableResize instead.
+template<int Channels, typename Pixel>
+inline void bicubicPixel2D(const ResizePlan& plan, const Pixel* src, size_t srcPitch, int channels, Pixel* dstPixel, int x, int y) {
+    assert(!plan.antialias);
+    const int xTaps = plan.xTaps;
+    const int yTaps = plan.yTaps;
+    const int* xIndex = &plan.xIndex[x * xTaps];
+    const float* xWeight = &plan.xWeight[x * xTaps];
+    const int* yIndex = &plan.yIndex[y * yTaps];
+    const float* yWeight = &plan.yWeight[y * yTaps];
+
+    bool interior = x >= plan.xInteriorBegin && x < plan.xInteriorEnd && y >= plan.yInteriorBegin && y < plan.yInteriorEnd;
+    if (Channels == 0 || !interior) {
+        for (int c = 0; c < channels; ++c) {
+            float result = 0.0f;
+            for (int m = 0; m < yTaps; ++m) {
+                for (int n = 0; n < xTaps; ++n) {
+                    float weight = xWeight[n] * yWeight[m];
+                    result += borderSample(plan, src, srcPitch, channels, xIndex[n], yIndex[m], c) * weight;
+                }
+            }
+            dstPixel[c] = PixelTraits<Pixel>::fromFloat(result);
+        }
+        return;
+    }
+
+    const int ch = Channels > 0 ? Channels : 1;
+    const Pixel* block = &src[yIndex[0] * srcPitch + (size_t)xIndex[0] * ch];
+
+    float result[ch] = {};
+    for (int m = 0; m < yTaps; ++m) {
+        const Pixel* srcRow = block + m * srcPitch;
+        for (int n = 0; n < xTaps; ++n) {
+            float weight = xWeight[n] * yWeight[m];
+            for (int c = 0; c < ch; ++c) {
+                result[c] += srcRow[n * ch + c] * weight;
+            }
+        }
+    }
+    for (int c = 0; c < ch; ++c) {
+        dstPixel[c] = PixelTraits<Pixel>::fromFloat(result[c]);
+    }
+}
+
+// Horizontal pass of one source row into a float intermediate row: the
+// interior columns read contiguous taps, the edge strips use the tables
+template<int Channels, typename Pixel>
+inline void horizontalRow(const ResizePlan& plan, const Pixel* srcRow, int channels, float* tmpRow) {
+    const int ch = Channels > 0 ? Channels : channels;
+    const int taps = plan.xTaps;
+
+    for (int x = 0; x < plan.dstWidth; ++x) {
+        const int* xIndex = &plan.xIndex[x * taps];
+        const float* xWeight = &plan.xWeight[x * taps];
+
+        if (x >= plan.xInteriorBegin && x < plan.xInteriorEnd) {
+            const Pixel* pixel = &srcRow[xIndex[0] * ch];
+            for (int c = 0; c < ch; ++c) {
+                float result = 0.0f;
+                for (int n = 0; n < taps; ++n) {
+                    result += pixel[n * ch + c] * xWeight[n];
+                }
+                tmpRow[x * ch + c] = result;
+            }
+            continue;
+        }
+
+        for (int c = 0; c < ch; ++c) {
+            float result = 0.0f;
+            for (int n = 0; n < taps; ++n) {
+                float value = xIndex[n] == plan.srcWidth ? (float)borderPixel<Pixel>(plan, c) : (float)srcRow[xIndex[n] * ch + c];
+                result += value * xWeight[n];
+            }
+            tmpRow[x * ch + c] = result;
+        }
+    }
+}
+
+// Vertical pass of one output row; lanes are channel-agnostic here
+template<typename Pixel>
+inline void verticalRow(const float* const* rows, const float* weight, int taps, Pixel* dstRow, int lanes) {
+    for (int i = 0; i < lanes; ++i) {
+        float result = 0.0f;
+        for (int m = 0; m < taps; ++m) {
+            result += rows[m][i] * weight[m];
+        }
+        dstRow[i] = PixelTraits<Pixel>::fromFloat(result);
+    }
+}
+
+// Two-pass resize: every source row filtered horizontally into a float
+// intermediate (srcHeight x dstWidth), which is then filtered vertically.
+// BORDER_CONSTANT appends the filtered constant row as row srcHeight. The
+// intermediate is borrowed from the shared BufferArena.
+template<int Channels, typename Pixel>
+void separableResize(const ResizePlan& plan, const Pixel* src, size_t srcPitch, int channels, Pixel* dst, size_t dstPitch) {
+    const int ch = Channels > 0 ? Channels : channels;
+    const int taps = plan.yTaps;
+    const int srcHeight = plan.srcHeight;
+    const int dstHeight = plan.dstHeight;
+    const size_t srcRowLength = (size_t)plan.srcWidth * ch;
+    const int lanes = plan.dstWidth * ch;
+    const int tmpRows = srcHeight + (plan.border == BORDER_CONSTANT ? 1 : 0);
+
+    ArenaBuffer<float> tmp((size_t)tmpRows * lanes);
+
+    #pragma omp parallel for
+    for (int y = 0; y < srcHeight; ++y) {
+        horizontalRow<Channels, Pixel>(plan, &src[y * srcPitch], ch, &tmp[(size_t)y * lanes]);
+    }
+
+    if (plan.border == BORDER_CONSTANT) {
+        std::vector<Pixel> constantRow(srcRowLength);
+        for (size_t i = 0; i < srcRowLength; ++i) {
+            constantRow[i] = borderPixel<Pixel>(plan, (int)(i % ch));
+        }
+        horizontalRow<Channels, Pixel>(plan, constantRow.data(), ch, &tmp[(size_t)srcHeight * lanes]);
+    }
+
+    #pragma omp parallel
+    {
+        std::vector<const float*> rows(taps);
+
+        #pragma omp for
+        for (int y = 0; y < dstHeight; ++y) {
+            for (int m = 0; m < taps; ++m) {
+                rows[m] = &tmp[(size_t)plan.yIndex[y * taps + m] * lanes];
+            }
+            verticalRow<Pixel>(rows.data(), &plan.yWeight[y * taps], taps, &dst[(size_t)y * dstPitch], lanes);
+        }
+    }
+}
+
+// Picks the compile-time instance for the channel count stbi_load reported
+template<typename Pixel>
+void separableResizeDispatch(const ResizePlan& plan, const Pixel* src, size_t srcPitch, int channels, Pixel* dst, size_t dstPitch) {
+    switch (channels) {
+    case 1: separableResize<1, Pixel>(plan, src, srcPitch, channels, dst, dstPitch); break;
+    case 2: separableResize<2, Pixel>(plan, src, srcPitch, channels, dst, dstPitch); break;
+    case 3: separableResize<3, Pixel>(plan, src, srcPitch, channels, dst, dstPitch); break;
+    case 4: separableResize<4, Pixel>(plan, src, srcPitch, channels, dst, dstPitch); break;
+    default: separableResize<0, Pixel>(plan, src, srcPitch, channels, dst, dstPitch); break;
+    }
+}
+
+// Output pixels [x0, x1) x [y0, y1) of the 2D resize; tiles are independent
+// so the tiled backends can hand them to any thread
+template<int Channels, typename Pixel>
+void bicubicTile(const ResizePlan& plan, const Pixel* src, size_t srcPitch, int channels, Pixel* dst, size_t dstPitch,
+    int x0, int y0, int x1, int y1) {
+    for (int y = y0; y < y1; ++y) {
+        Pixel* dstRow = &dst[(size_t)y * dstPitch];
+        for (int x = x0; x < x1; ++x) {
+            bicubicPixel2D<Channels, Pixel>(plan, src, srcPitch, channels, &dstRow[(size_t)x * channels], x, y);
+        }
+    }
+}
+
+template<typename Pixel>
+void bicubicTileDispatch(const ResizePlan& plan, const Pixel* src, size_t srcPitch, int channels, Pixel* dst, size_t dstPitch,
+    int x0, int y0, int x1, int y1) {
+    switch (channels) {
+    case 1: bicubicTile<1, Pixel>(plan, src, srcPitch, channels, dst, dstPitch, x0, y0, x1, y1); break;
+    case 2: bicubicTile<2, Pixel>(plan, src, srcPitch, channels, dst, dstPitch, x0, y0, x1, y1); break;
+    case 3: bicubicTile<3, Pixel>(plan, src, srcPitch, channels, dst, dstPitch, x0, y0, x1, y1); break;
+    case 4: bicubicTile<4, Pixel>(plan, src, srcPitch, channels, dst, dstPitch, x0, y0, x1, y1); break;
+    default: bicubicTile<0, Pixel>(plan, src, srcPitch, channels, dst, dstPitch, x0, y0, x1, y1); break;
+    }
+}
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include "resizeEngine.h"
+
+using namespace std;
+
+// yields before an idle worker or a blocked submitter falls asleep
+static const int spinLimit = 2000;
+
+ResizeEngine::ResizeEngine(ResizeFunc executor, int workerCount, size_t queueCapacity)
+    : executor(executor), queue(max<size_t>(queueCapacity, 1)), fullEvents(0), sleepingWorkers(0), sleepingSubmitters(0), stopping(false) {
+    for (int i = 0; i < max(workerCount, 1); ++i) {
+        workers.push_back(thread(&ResizeEngine::workerLoop, this));
+    }
+}
+
+ResizeEngine::~ResizeEngine() {
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    notEmpty.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+future<ResizeResult> ResizeEngine::submit(const ResizeJob& job, CancelFlag cancel) {
+    // std::function needs a copyable callable, so the promise is shared
+    shared_ptr<promise<ResizeResult>> result = make_shared<promise<ResizeResult>>();
+    future<ResizeResult> done = result->get_future();
+    enqueue(QueuedJob{ job, cancel, [result](ResizeResult status) { result->set_value(status); },
+        [result](exception_ptr error) { result->set_exception(error); } });
+    return done;
+}
+
+void ResizeEngine::submit(const ResizeJob& job, function<void(ResizeResult)> onComplete, CancelFlag cancel) {
+    enqueue(QueuedJob{ job, cancel, onComplete, nullptr });
+}
+
+bool ResizeEngine::trySubmit(const ResizeJob& job, function<void(ResizeResult)> onComplete, CancelFlag cancel) {
+    if (!queue.tryPush(QueuedJob{ job, cancel, onComplete, nullptr })) {
+        fullEvents++;
+        return false;
+    }
+    wakeSleepers(sleepingWorkers, notEmpty);
+    return true;
+}
+
+void ResizeEngine::enqueue(QueuedJob queued) {
+    int idle = 0;
+    bool counted = false;
+    while (!queue.tryPush(move(queued))) {
+        if (!counted) {
+            fullEvents++;
+            counted = true;
+        }
+        if (++idle < spinLimit) {
+            this_thread::yield();
+            continue;
+        }
+
+        unique_lock<mutex> lock(sleepMutex);
+        sleepingSubmitters++;
+        notFull.wait(lock, [this] { return queue.sizeApprox() < queue.capacity(); });
+        sleepingSubmitters--;
+        idle = 0;
+    }
+    wakeSleepers(sleepingWorkers, notEmpty);
+}
+
+void ResizeEngine::wakeSleepers(atomic<int>& sleepers, condition_variable& condition) {
+    // orders the queue update before the check; the sleeper registers before
+    // re-testing the queue under the mutex, so one side always sees the other
+    atomic_thread_fence(memory_order_seq_cst);
+    if (sleepers.load() == 0) {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(sleepMutex);
+    }
+    condition.notify_one();
+}
+
+void ResizeEngine::workerLoop() {
+    int idle = 0;
+    while (true) {
+        QueuedJob queued;
+        if (!queue.tryPop(queued)) {
+            // a claimed but unpublished push still counts, so nothing submitted is lost
+            if (stopping.load() && queue.sizeApprox() == 0) {
+                return;
+            }
+            if (++idle < spinLimit) {
+                this_thread::yield();
+                continue;
+            }
+
+            unique_lock<mutex> lock(sleepMutex);
+            sleepingWorkers++;
+            notEmpty.wait(lock, [this] { return stopping.load() || queue.sizeApprox() > 0; });
+            sleepingWorkers--;
+            idle = 0;
+            continue;
+        }
+        idle = 0;
+        wakeSleepers(sleepingSubmitters, notFull);
+
+        // an exception escaping this thread would terminate the process
+        ResizeResult status = RESIZE_CANCELLED;
+        exception_ptr error;
+        if (!queued.cancel || !queued.cancel->load()) {
+            const ResizeJob& job = queued.job;
+            try {
+                executor(job.src, job.srcWidth, job.srcHeight, job.channels, job.dst, job.dstWidth, job.dstHeight);
+                status = RESIZE_COMPLETED;
+            }
+            catch (...) {
+                error = current_exception();
+                status = RESIZE_FAILED;
+            }
+        }
+        try {
+            if (error && queued.onError) {
+                queued.onError(error);
+            }
+            else if (queued.onComplete) {
+                queued.onComplete(status);
+            }
+        }
+        catch (...) {
+            // nowhere to report a failing callback; the next job still runs
+        }
+    }
+}
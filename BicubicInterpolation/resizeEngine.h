@@ -0,0 +1,92 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "batch_ResizeBicubic.h"
+#include "mpmcQueue.h"
+
+typedef void (*ResizeFunc)(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+
+enum ResizeResult {
+    RESIZE_COMPLETED,
+    RESIZE_CANCELLED,
+    RESIZE_FAILED      // the executor threw (e.g. bad_alloc); the output is undefined
+};
+
+// Set to true to drop a job that has not started yet. The executors are plain
+// resizeFuncs, so a job that is already running always completes.
+typedef std::shared_ptr<std::atomic<bool>> CancelFlag;
+
+inline CancelFlag makeCancelFlag() { return std::make_shared<std::atomic<bool>>(false); }
+
+// Asynchronous front end over any resizeFunc executor. Jobs wait in a bounded
+// lock-free MpmcQueue and run on the engine's own threads, so callers can keep
+// decoding and encoding while resizes are in flight. submit blocks while the
+// queue is full; trySubmit returns false instead, for callers that would
+// rather shed or defer load. Idle workers and blocked submitters spin briefly
+// and only then sleep, so the mutex below is off the path while jobs flow.
+// serial_ResizeBicubic with several workers runs independent images side by
+// side; openMP_ResizeBicubic with one worker gives each image every core.
+class ResizeEngine {
+public:
+    // queueCapacity is rounded up to a power of two
+    ResizeEngine(ResizeFunc executor, int workers = 1, size_t queueCapacity = 64);
+
+    // Finishes every queued job before returning
+    ~ResizeEngine();
+
+    ResizeEngine(const ResizeEngine&) = delete;
+    ResizeEngine& operator=(const ResizeEngine&) = delete;
+
+    // An exception thrown by the executor is rethrown from the future's get()
+    std::future<ResizeResult> submit(const ResizeJob& job, CancelFlag cancel = CancelFlag());
+
+    // onComplete runs on an engine thread once the job finishes, is dropped or
+    // fails; exceptions it throws are swallowed so the worker keeps running
+    void submit(const ResizeJob& job, std::function<void(ResizeResult)> onComplete, CancelFlag cancel = CancelFlag());
+
+    // Back-pressure: false, with nothing queued, when the queue is full
+    bool trySubmit(const ResizeJob& job, std::function<void(ResizeResult)> onComplete, CancelFlag cancel = CancelFlag());
+
+    size_t queueCapacity() const { return queue.capacity(); }
+
+    // Jobs waiting for a worker; a hint while submitters and workers run
+    size_t queuedJobs() const { return queue.sizeApprox(); }
+
+    // Submissions that found the queue full, whether they then waited or were refused
+    size_t fullCount() const { return fullEvents.load(); }
+
+private:
+    struct QueuedJob {
+        ResizeJob job;
+        CancelFlag cancel;
+        std::function<void(ResizeResult)> onComplete;
+        std::function<void(std::exception_ptr)> onError;  // takes over from onComplete on failure when set
+    };
+
+    void enqueue(QueuedJob queued);
+    void wakeSleepers(std::atomic<int>& sleepers, std::condition_variable& condition);
+    void workerLoop();
+
+    ResizeFunc executor;
+
+    MpmcQueue<QueuedJob> queue;
+    std::atomic<size_t> fullEvents;
+
+    // sleeping workers wait on notEmpty, blocked submitters on notFull; the
+    // counters let the other side skip the mutex when nobody sleeps
+    std::mutex sleepMutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::atomic<int> sleepingWorkers;
+    std::atomic<int> sleepingSubmitters;
+    std::atomic<bool> stopping;
+
+    std::vector<std::thread> workers;
+};
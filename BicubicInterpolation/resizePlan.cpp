@@ -0,0 +1,118 @@
+#include <iostream>
+#include "resizePlan.h"
+#include "cpuFeatures.h"
+
+using namespace std;
+
+int borderIndex(int i, int size, BorderMode border) {
+    if (i >= 0 && i < size) {
+        return i;
+    }
+
+    switch (border) {
+    case BORDER_REFLECT: {
+        int period = 2 * size;
+        i %= period;
+        if (i < 0) {
+            i += period;
+        }
+        return i < size ? i : period - 1 - i;
+    }
+    case BORDER_WRAP:
+        i %= size;
+        return i < 0 ? i + size : i;
+    case BORDER_CONSTANT:
+        return size;
+    default:
+        return max(0, min(i, size - 1));
+    }
+}
+
+void planTileSize(const ResizePlan& plan, int channels, int workers, int& tileWidth, int& tileHeight) {
+    static const int l2Bytes = detectL2CacheBytes();
+    size_t budget = (size_t)l2Bytes / 2;
+
+    double scaleX = (double)plan.srcWidth / plan.dstWidth;
+    double scaleY = (double)plan.srcHeight / plan.dstHeight;
+
+    // wide enough for whole cache lines of output, then as tall as the budget allows
+    tileWidth = min(plan.dstWidth, 256);
+    size_t srcRowBytes = (size_t)(tileWidth * scaleX + plan.xTaps) * channels;
+    size_t dstRowBytes = (size_t)tileWidth * channels;
+
+    // tile rows h cover h * scaleY + yTaps source rows
+    double rowsFit = (double)(budget / max<size_t>(srcRowBytes, 1)) - plan.yTaps;
+    tileHeight = (int)(rowsFit / (scaleY + (double)dstRowBytes / srcRowBytes));
+    tileHeight = max(1, min(tileHeight, plan.dstHeight));
+
+    // keep enough tiles for the dynamic schedule to balance
+    int tilesX = (plan.dstWidth + tileWidth - 1) / tileWidth;
+    int minTiles = 4 * max(workers, 1);
+    while (tileHeight > 8 && tilesX * ((plan.dstHeight + tileHeight - 1) / tileHeight) < minTiles) {
+        tileHeight /= 2;
+    }
+}
+
+// [first, end) of the real taps of outputs [i0, i1) on one axis
+static void axisSourceRange(const vector<int>& index, int taps, int srcSize, int i0, int i1, int& first, int& end) {
+    first = srcSize;
+    end = 0;
+    for (size_t k = (size_t)i0 * taps; k < (size_t)i1 * taps; ++k) {
+        if (index[k] < srcSize) {
+            first = min(first, index[k]);
+            end = max(end, index[k] + 1);
+        }
+    }
+    if (first >= end) {
+        first = end = 0;  // only virtual taps
+    }
+}
+
+// Taps of outputs [i0, i1) rebased to the window starting at first; the
+// virtual BORDER_CONSTANT tap moves to the window's own one-past-the-end
+static void windowAxis(const vector<int>& index, const vector<float>& weight, int taps, int srcSize, int interiorBegin, int interiorEnd,
+    int i0, int i1, int first, int windowSize, vector<int>& windowIndex, vector<float>& windowWeight, int& windowBegin, int& windowEnd) {
+    windowIndex.resize((size_t)(i1 - i0) * taps);
+    windowWeight.assign(weight.begin() + (size_t)i0 * taps, weight.begin() + (size_t)i1 * taps);
+    for (size_t k = 0; k < windowIndex.size(); ++k) {
+        int i = index[(size_t)i0 * taps + k];
+        windowIndex[k] = i == srcSize ? windowSize : i - first;
+    }
+
+    // interior outputs keep contiguous taps after the shift
+    windowBegin = min(max(interiorBegin, i0), i1) - i0;
+    windowEnd = max(min(interiorEnd, i1), i0) - i0;
+    if (windowEnd <= windowBegin) {
+        windowBegin = windowEnd = i1 - i0;
+    }
+}
+
+void planSourceColumns(const ResizePlan& plan, int x0, int x1, int& first, int& end) {
+    axisSourceRange(plan.xIndex, plan.xTaps, plan.srcWidth, x0, x1, first, end);
+}
+
+void planSourceRows(const ResizePlan& plan, int y0, int y1, int& first, int& end) {
+    axisSourceRange(plan.yIndex, plan.yTaps, plan.srcHeight, y0, y1, first, end);
+}
+
+ResizePlan windowResizePlan(const ResizePlan& plan, int x0, int y0, int x1, int y1, int& srcX0, int& srcY0) {
+    int xEnd, yEnd;
+    planSourceColumns(plan, x0, x1, srcX0, xEnd);
+    planSourceRows(plan, y0, y1, srcY0, yEnd);
+
+    ResizePlan window;
+    window.srcWidth = xEnd - srcX0;
+    window.srcHeight = yEnd - srcY0;
+    window.dstWidth = x1 - x0;
+    window.dstHeight = y1 - y0;
+    window.xTaps = plan.xTaps;
+    window.yTaps = plan.yTaps;
+    window.antialias = plan.antialias;
+    window.border = plan.border;
+    window.borderColor = plan.borderColor;
+    windowAxis(plan.xIndex, plan.xWeight, plan.xTaps, plan.srcWidth, plan.xInteriorBegin, plan.xInteriorEnd,
+        x0, x1, srcX0, window.srcWidth, window.xIndex, window.xWeight, window.xInteriorBegin, window.xInteriorEnd);
+    windowAxis(plan.yIndex, plan.yWeight, plan.yTaps, plan.srcHeight, plan.yInteriorBegin, plan.yInteriorEnd,
+        y0, y1, srcY0, window.srcHeight, window.yIndex, window.yWeight, window.yInteriorBegin, window.yInteriorEnd);
+    return window;
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include "cubicKernels.h"
+#include "lanczosKernels.h"
+
+// How taps that fall outside the source are resolved
+enum BorderMode {
+    BORDER_CLAMP,     // repeat the edge pixel (aaa|abcd|ddd)
+    BORDER_REFLECT,   // mirror including the edge (cba|abcd|dcb)
+    BORDER_WRAP,      // tile the image (bcd|abcd|abc)
+    BORDER_CONSTANT   // borderColor
+};
+
+// Map a source coordinate outside [0, size) back into the image
+// (BORDER_CONSTANT maps it to size, see ResizePlan)
+int borderIndex(int i, int size, BorderMode border);
+
+// Fill the tap tables of one axis. Uses the same float math as the original
+// per-pixel loops (src = i * scale, taps at (int)src - 1 .. (int)src + 2), so
+// plan-based backends produce identical weights. Kernel::weight inlines here,
+// the resize loops only ever see the tables.
+//
+// With antialias set, a downscale stretches the kernel by the scale factor so
+// every source pixel under the output footprint contributes (area-weighted
+// convolution); taps grow linearly with the scale. Sample positions are then
+// centre-aligned, (i + 0.5) * scale - 0.5, and weights are normalised.
+// Such plans are for the separable backends only: a 2D pass would cost
+// xTaps * yTaps per output pixel, so the 2D paths assert against them.
+template<typename Kernel>
+void buildPlanAxis(int srcSize, int dstSize, bool antialias, BorderMode border,
+    int& taps, std::vector<int>& index, std::vector<float>& weight, int& interiorBegin, int& interiorEnd) {
+    float scale = (float)srcSize / dstSize;
+    float filterScale = antialias ? std::max(scale, 1.0f) : 1.0f;
+    float radius = Kernel::support * filterScale;
+    bool normalize = Kernel::normalized || antialias;
+
+    taps = filterScale > 1.0f ? (int)std::ceil(2.0f * radius) + 1 : 2 * Kernel::support;
+    index.resize((size_t)dstSize * taps);
+    weight.resize((size_t)dstSize * taps);
+    interiorBegin = dstSize;
+    interiorEnd = dstSize;
+
+    for (int i = 0; i < dstSize; ++i) {
+        float src;
+        int first;
+        if (antialias) {
+            src = (i + 0.5f) * scale - 0.5f;
+            first = (int)std::floor(src - radius) + 1;
+        }
+        else {
+            src = i * scale;
+            first = (int)src - (Kernel::support - 1);
+        }
+
+        float sum = 0.0f;
+        for (int k = 0; k < taps; ++k) {
+            float d = src - (first + k);
+            if (filterScale > 1.0f) {
+                d /= filterScale;
+            }
+            index[i * taps + k] = borderIndex(first + k, srcSize, border);
+            weight[i * taps + k] = Kernel::weight(d);
+            sum += weight[i * taps + k];
+        }
+
+        // windowed sinc and stretched kernels do not sum to 1, rescale so flat areas stay flat
+        if (normalize && sum != 0.0f) {
+            for (int k = 0; k < taps; ++k) {
+                weight[i * taps + k] /= sum;
+            }
+        }
+
+        // first taps are monotonic in i, so the interior is one contiguous range
+        bool inside = first >= 0 && first + taps <= srcSize;
+        if (inside && interiorBegin == dstSize) {
+            interiorBegin = i;
+        }
+        if (inside) {
+            interiorEnd = i + 1;
+        }
+    }
+}
+
+// Per-axis filter tables for one (srcWidth, srcHeight, dstWidth, dstHeight, kernel).
+// For output column x, tap k reads source column xIndex[x * xTaps + k] (already
+// mapped into the image by the border mode) with weight xWeight[x * xTaps + k];
+// rows likewise with yTaps. The two differ for antialiased plans whose x and y
+// scales differ. The kernel is a type from cubicKernels.h or lanczosKernels.h,
+// passed as a tag: ResizePlan(w, h, dw, dh, MitchellKernel()). Wider kernels
+// simply give more taps per output sample.
+//
+// Output columns [xInteriorBegin, xInteriorEnd) only touch source columns
+// inside the image, so their taps are contiguous from xIndex[x * xTaps] and can
+// be read straight from a row pointer; only the thin strips outside need the
+// tables. Rows likewise.
+//
+// With BORDER_CONSTANT an outside tap has index srcWidth (srcHeight): a
+// virtual pixel (row) one past the edge that holds borderColor. Backends
+// either append such a pixel/row to their buffers or test for it on the
+// border strips.
+struct ResizePlan {
+    int srcWidth, srcHeight;
+    int dstWidth, dstHeight;
+    int xTaps, yTaps;
+    bool antialias;
+    BorderMode border;
+    std::vector<float> borderColor;
+
+    std::vector<int> xIndex;
+    std::vector<float> xWeight;
+    std::vector<int> yIndex;
+    std::vector<float> yWeight;
+
+    int xInteriorBegin, xInteriorEnd;
+    int yInteriorBegin, yInteriorEnd;
+
+    // Empty plan, for windowResizePlan to fill in
+    ResizePlan() : srcWidth(0), srcHeight(0), dstWidth(0), dstHeight(0), xTaps(0), yTaps(0), antialias(false),
+        border(BORDER_CLAMP), xInteriorBegin(0), xInteriorEnd(0), yInteriorBegin(0), yInteriorEnd(0) {}
+
+    template<typename Kernel = CatmullRomKernel>
+    ResizePlan(int srcWidth, int srcHeight, int dstWidth, int dstHeight, Kernel = Kernel(),
+        BorderMode border = BORDER_CLAMP, const std::vector<float>& borderColor = std::vector<float>(), bool antialias = false)
+        : srcWidth(srcWidth), srcHeight(srcHeight), dstWidth(dstWidth), dstHeight(dstHeight), antialias(antialias),
+        border(border), borderColor(borderColor) {
+        buildPlanAxis<Kernel>(srcWidth, dstWidth, antialias, border, xTaps, xIndex, xWeight, xInteriorBegin, xInteriorEnd);
+        buildPlanAxis<Kernel>(srcHeight, dstHeight, antialias, border, yTaps, yIndex, yWeight, yInteriorBegin, yInteriorEnd);
+    }
+
+    // BORDER_CONSTANT value of channel c (0 for channels without a colour)
+    float borderValue(int c) const { return c < (int)borderColor.size() ? borderColor[c] : 0.0f; }
+};
+
+// Returns a cached plan, building it on first use; one cache per kernel type
+// and antialias setting
+template<typename Kernel = CatmullRomKernel, bool Antialias = false>
+std::shared_ptr<const ResizePlan> getResizePlan(int srcWidth, int srcHeight, int dstWidth, int dstHeight) {
+    typedef std::tuple<int, int, int, int> PlanKey;
+    static std::map<PlanKey, std::shared_ptr<const ResizePlan>> cache;
+    static std::mutex cacheMutex;
+
+    // keep the cache small, experiments only cycle through a handful of sizes
+    const size_t maxCachedPlans = 16;
+
+    PlanKey key(srcWidth, srcHeight, dstWidth, dstHeight);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        return it->second;
+    }
+
+    if (cache.size() >= maxCachedPlans) {
+        cache.clear();
+    }
+
+    std::shared_ptr<const ResizePlan> plan = std::make_shared<ResizePlan>(srcWidth, srcHeight, dstWidth, dstHeight, Kernel(),
+        BORDER_CLAMP, std::vector<float>(), Antialias);
+    cache[key] = plan;
+    return plan;
+}
+
+// Source columns [first, end) that output columns [x0, x1) read; BORDER_CONSTANT
+// virtual taps are left out. planSourceRows is the same for rows.
+void planSourceColumns(const ResizePlan& plan, int x0, int x1, int& first, int& end);
+void planSourceRows(const ResizePlan& plan, int y0, int y1, int& first, int& end);
+
+// Plan for output rectangle [x0, x1) x [y0, y1) alone, with its taps rebased
+// into the source window it reads, starting at (srcX0, srcY0) and sized by the
+// returned plan's srcWidth x srcHeight. Running it on a copy of just that
+// window gives the same pixels as the full plan, which is how the out-of-core
+// resize works on images that never fit in memory.
+ResizePlan windowResizePlan(const ResizePlan& plan, int x0, int y0, int x1, int y1, int& srcX0, int& srcY0);
+
+// Output tile size for the tiled backends: up to 256 pixels wide and as tall
+// as keeps the tile's source footprint within half of L2, while leaving at
+// least 4 tiles per worker
+void planTileSize(const ResizePlan& plan, int channels, int workers, int& tileWidth, int& tileHeight);
@@ -0,0 +1,59 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "resizeCore.h"
+#include "separable_ResizeBicubic.h"
+
+using namespace std;
+
+// Two-pass bicubic resize, see separableResize in resizeCore.h.
+// Each output sample costs 4 + 4 taps instead of 4 x 4 (xTaps + yTaps for
+// wider or antialiased plans).
+void separable_ResizeBicubic(const ResizePlan& plan, const ImageView& src, const ImageView& dst) {
+    separableResizeDispatch<unsigned char>(plan, src.data, src.pitch, src.channels, dst.data, dst.pitch);
+}
+
+void separable_ResizeBicubic(const ResizePlan& plan, unsigned char* src, int channels, unsigned char* dst) {
+    separableResizeDispatch<unsigned char>(plan, src, (size_t)plan.srcWidth * channels, channels, dst, (size_t)plan.dstWidth * channels);
+}
+
+void separable_ResizeBicubic(const ResizePlan& plan, const unsigned short* src, int channels, unsigned short* dst) {
+    separableResizeDispatch<unsigned short>(plan, src, (size_t)plan.srcWidth * channels, channels, dst, (size_t)plan.dstWidth * channels);
+}
+
+void separable_ResizeBicubic(const ResizePlan& plan, const float* src, int channels, float* dst) {
+    separableResizeDispatch<float>(plan, src, (size_t)plan.srcWidth * channels, channels, dst, (size_t)plan.dstWidth * channels);
+}
+
+void separable_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels,
+    unsigned char* dst, int dstWidth, int dstHeight) {
+    separable_ResizeBicubic(*getResizePlan(srcWidth, srcHeight, dstWidth, dstHeight), src, channels, dst);
+}
+
+void separable_ResizeBicubic(const ImageView& src, const ImageView& dst) {
+    separable_ResizeBicubic(*getResizePlan(src.width, src.height, dst.width, dst.height), src, dst);
+}
+
+int separable_CheckAntialias(int& plainDeviation) {
+    // a 1-pixel checkerboard averages to mid-gray under any footprint wider than a pixel
+    const int srcWidth = 1600, srcHeight = 1200, dstWidth = 100, dstHeight = 150;
+    vector<unsigned char> src((size_t)srcWidth * srcHeight);
+    for (int y = 0; y < srcHeight; ++y) {
+        for (int x = 0; x < srcWidth; ++x) {
+            src[(size_t)y * srcWidth + x] = (x + y) % 2 ? 255 : 0;
+        }
+    }
+
+    vector<unsigned char> antialiased((size_t)dstWidth * dstHeight), plain(antialiased.size());
+    separable_AntialiasResize<CatmullRomKernel>(src.data(), srcWidth, srcHeight, 1, antialiased.data(), dstWidth, dstHeight);
+    separable_ResizeBicubic(src.data(), srcWidth, srcHeight, 1, plain.data(), dstWidth, dstHeight);
+
+    int deviation = 0;
+    plainDeviation = 0;
+    for (size_t i = 0; i < antialiased.size(); ++i) {
+        deviation = max(deviation, abs((int)antialiased[i] - 128));
+        plainDeviation = max(plainDeviation, abs((int)plain[i] - 128));
+    }
+    return deviation;
+}
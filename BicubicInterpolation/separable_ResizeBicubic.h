@@ -0,0 +1,42 @@
+#pragma once
+#include "resizePlan.h"
+#include "imageView.h"
+void separable_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+void separable_ResizeBicubic(const ResizePlan& plan, unsigned char* src, int channels, unsigned char* dst);
+
+// Strided source and destination; the plan sizes are the view sizes
+void separable_ResizeBicubic(const ResizePlan& plan, const ImageView& src, const ImageView& dst);
+void separable_ResizeBicubic(const ImageView& src, const ImageView& dst);
+
+// 16-bit and float images, same engine
+void separable_ResizeBicubic(const ResizePlan& plan, const unsigned short* src, int channels, unsigned short* dst);
+void separable_ResizeBicubic(const ResizePlan& plan, const float* src, int channels, float* dst);
+
+// resizeFunc-compatible entry point for any plan kernel,
+// e.g. resizeImage(separable_Resize<MitchellKernel>, ...)
+template<typename Kernel>
+void separable_Resize(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight) {
+    separable_ResizeBicubic(*getResizePlan<Kernel>(srcWidth, srcHeight, dstWidth, dstHeight), src, channels, dst);
+}
+
+template<typename Kernel>
+void separable_Resize(const ImageView& src, const ImageView& dst) {
+    separable_ResizeBicubic(*getResizePlan<Kernel>(src.width, src.height, dst.width, dst.height), src, dst);
+}
+
+// Antialiased variant: on downscales the kernel support stretches by the scale
+// factor so the whole source footprint is averaged, e.g. for thumbnails
+template<typename Kernel>
+void separable_AntialiasResize(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight) {
+    separable_ResizeBicubic(*getResizePlan<Kernel, true>(srcWidth, srcHeight, dstWidth, dstHeight), src, channels, dst);
+}
+
+template<typename Kernel>
+void separable_AntialiasResize(const ImageView& src, const ImageView& dst) {
+    separable_ResizeBicubic(*getResizePlan<Kernel, true>(src.width, src.height, dst.width, dst.height), src, dst);
+}
+
+// Largest distance from mid-gray (128) after separable_AntialiasResize takes a
+// 1-pixel checkerboard from 1600x1200 to 100x150; plainDeviation gets the same
+// for the plain plan, which aliases towards solid black or white
+int separable_CheckAntialias(int& plainDeviation);
@@ -1,33 +1,75 @@
 #include <iostream>
-#include "bicubicKernel.h"
+#include <vector>
+#include <cassert>
+#include "resizeCore.h"
+#include "serial_ResizeBicubic.h"
 
 using namespace std;
 
-void serial_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels,
-    unsigned char* dst, int dstWidth, int dstHeight) {
-    float scaleX = (float)srcWidth / dstWidth;
-    float scaleY = (float)srcHeight / dstHeight;
+void serial_ResizeBicubic(const ResizePlan& plan, const ImageView& srcView, const ImageView& dstView) {
+    // the 2D reference; antialiased plans are separable-only (see resizePlan.h)
+    assert(!plan.antialias);
+    const unsigned char* src = srcView.data;
+    size_t srcPitch = srcView.pitch;
+    int channels = srcView.channels;
+    int srcWidth = plan.srcWidth;
+    int dstWidth = plan.dstWidth;
+    int dstHeight = plan.dstHeight;
+    int xTaps = plan.xTaps;
+    int yTaps = plan.yTaps;
+
+    // BORDER_CONSTANT taps point one past the edge, so give the reference loop a
+    // copy with an extra column and row of border colour to read them from
+    vector<unsigned char> padded;
+    if (plan.border == BORDER_CONSTANT) {
+        int paddedWidth = srcWidth + 1;
+        padded.resize((size_t)paddedWidth * (plan.srcHeight + 1) * channels);
+        for (int y = 0; y <= plan.srcHeight; ++y) {
+            for (int x = 0; x < paddedWidth; ++x) {
+                for (int c = 0; c < channels; ++c) {
+                    bool inside = x < srcWidth && y < plan.srcHeight;
+                    padded[((size_t)y * paddedWidth + x) * channels + c] = inside ? src[(size_t)y * srcPitch + (size_t)x * channels + c] : borderPixel<unsigned char>(plan, c);
+                }
+            }
+        }
+        src = padded.data();
+        srcPitch = (size_t)paddedWidth * channels;
+    }
 
     for (int y = 0; y < dstHeight; ++y) {
+        const int* yIndex = &plan.yIndex[y * yTaps];
+        const float* yWeight = &plan.yWeight[y * yTaps];
+
         for (int x = 0; x < dstWidth; ++x) {
-            for (int c = 0; c < channels; ++c) {
-                float srcX = x * scaleX;
-                float srcY = y * scaleY;
-                int x1 = (int)srcX;
-                int y1 = (int)srcY;
+            const int* xIndex = &plan.xIndex[x * xTaps];
+            const float* xWeight = &plan.xWeight[x * xTaps];
 
+            for (int c = 0; c < channels; ++c) {
                 float result = 0.0f;
-                for (int m = -1; m <= 2; ++m) {
-                    for (int n = -1; n <= 2; ++n) {
-                        float weight = bicubicKernel(srcX - (x1 + n)) * bicubicKernel(srcY - (y1 + m));
-                        result += getPixelValue(src, srcWidth, srcHeight, channels, x1 + n, y1 + m, c) * weight;
+                for (int m = 0; m < yTaps; ++m) {
+                    for (int n = 0; n < xTaps; ++n) {
+                        float weight = xWeight[n] * yWeight[m];
+                        result += src[yIndex[m] * srcPitch + (size_t)xIndex[n] * channels + c] * weight;
                     }
                 }
 
-                dst[(y * dstWidth + x) * channels + c] = min(max((int)result, 0), 255);
+                dstView.row(y)[x * channels + c] = min(max((int)result, 0), 255);
             }
         }
     }
 }
 
+void serial_ResizeBicubic(const ResizePlan& plan, unsigned char* src, int channels, unsigned char* dst) {
+    serial_ResizeBicubic(plan, ImageView(src, plan.srcWidth, plan.srcHeight, channels), ImageView(dst, plan.dstWidth, plan.dstHeight, channels));
+}
+
+void serial_ResizeBicubic(const ImageView& src, const ImageView& dst) {
+    serial_ResizeBicubic(*getResizePlan(src.width, src.height, dst.width, dst.height), src, dst);
+}
+
+void serial_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels,
+    unsigned char* dst, int dstWidth, int dstHeight) {
+    serial_ResizeBicubic(*getResizePlan(srcWidth, srcHeight, dstWidth, dstHeight), src, channels, dst);
+}
+
 
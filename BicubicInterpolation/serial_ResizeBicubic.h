@@ -1,2 +1,16 @@
 #pragma once
-void serial_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
\ No newline at end of file
+#include "resizePlan.h"
+#include "imageView.h"
+void serial_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+void serial_ResizeBicubic(const ResizePlan& plan, unsigned char* src, int channels, unsigned char* dst);
+
+// Strided source and destination, e.g. a crop of a larger image resized into
+// a region of a canvas; the plan sizes are the view sizes
+void serial_ResizeBicubic(const ResizePlan& plan, const ImageView& src, const ImageView& dst);
+void serial_ResizeBicubic(const ImageView& src, const ImageView& dst);
+
+// resizeFunc-compatible entry point for any plan kernel, e.g. serial_Resize<Lanczos3Kernel>
+template<typename Kernel>
+void serial_Resize(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight) {
+    serial_ResizeBicubic(*getResizePlan<Kernel>(srcWidth, srcHeight, dstWidth, dstHeight), src, channels, dst);
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+// Per-ISA kernels are compiled with function-level target attributes so one
+// binary carries all of them; MSVC allows the intrinsics without flags.
+#if defined(_MSC_VER)
+#define SIMD_TARGET(isa)
+#else
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// Filter kernels work on "lanes": lane j is output column j / channels,
+// channel j % channels. Tables are tap-major, laneIndex[k * lanes + j] is the
+// float offset into the source row read by tap k of lane j.
+struct SimdKernels {
+    // tmpRow[j] = sum_k laneWeight[k * lanes + j] * srcRow[laneIndex[k * lanes + j]]
+    void (*horizontal)(const float* srcRow, float* tmpRow, const int* laneIndex, const float* laneWeight, int lanes, int taps);
+    // dstRow[j] = clamp((int)sum_m weight[m] * rows[m][j], 0, 255)
+    void (*vertical)(const float* const* rows, const float* weight, int taps, unsigned char* dstRow, int lanes);
+};
+
+// Scalar lanes [begin, lanes), used by the fallback and for vector tails
+inline void horizontalLanes(const float* srcRow, float* tmpRow, const int* laneIndex, const float* laneWeight, int lanes, int taps, int begin) {
+    for (int j = begin; j < lanes; ++j) {
+        float result = 0.0f;
+        for (int k = 0; k < taps; ++k) {
+            result += srcRow[laneIndex[k * lanes + j]] * laneWeight[k * lanes + j];
+        }
+        tmpRow[j] = result;
+    }
+}
+
+inline void verticalLanes(const float* const* rows, const float* weight, int taps, unsigned char* dstRow, int lanes, int begin) {
+    for (int j = begin; j < lanes; ++j) {
+        float result = 0.0f;
+        for (int m = 0; m < taps; ++m) {
+            result += rows[m][j] * weight[m];
+        }
+        int value = (int)result;
+        dstRow[j] = (unsigned char)(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+}
+
+void horizontal_Scalar(const float* srcRow, float* tmpRow, const int* laneIndex, const float* laneWeight, int lanes, int taps);
+void vertical_Scalar(const float* const* rows, const float* weight, int taps, unsigned char* dstRow, int lanes);
+void horizontal_SSE41(const float* srcRow, float* tmpRow, const int* laneIndex, const float* laneWeight, int lanes, int taps);
+void vertical_SSE41(const float* const* rows, const float* weight, int taps, unsigned char* dstRow, int lanes);
+void horizontal_AVX2(const float* srcRow, float* tmpRow, const int* laneIndex, const float* laneWeight, int lanes, int taps);
+void vertical_AVX2(const float* const* rows, const float* weight, int taps, unsigned char* dstRow, int lanes);
+void horizontal_AVX512(const float* srcRow, float* tmpRow, const int* laneIndex, const float* laneWeight, int lanes, int taps);
+void vertical_AVX512(const float* const* rows, const float* weight, int taps, unsigned char* dstRow, int lanes);
+
+// Fixed-point pipeline: Q14 int16 weights, int32 accumulators, int16
+// intermediates holding the horizontally filtered value in Q6. With bicubic
+// overshoot (< 1.25 x 255) the intermediate stays below 2^15 and the
+// vertical accumulator (Q20) below 2^31.
+const int FIXED_WEIGHT_BITS = 14;
+const int FIXED_INTERMEDIATE_BITS = 6;
+const int FIXED_HORIZONTAL_SHIFT = FIXED_WEIGHT_BITS - FIXED_INTERMEDIATE_BITS;
+const int FIXED_VERTICAL_SHIFT = FIXED_WEIGHT_BITS + FIXED_INTERMEDIATE_BITS;
+
+struct FixedPointKernels {
+    // tmpRow[j] = round(sum_k laneWeight[k * lanes + j] * srcRow[laneIndex[k * lanes + j]] >> FIXED_HORIZONTAL_SHIFT)
+    // srcRow must have one readable element past its end
+    void (*horizontal)(const short* srcRow, short* tmpRow, const int* laneIndex, const short* laneWeight, int lanes, int taps);
+    // dstRow[j] = clamp(round(sum_m weight[m] * rows[m][j] >> FIXED_VERTICAL_SHIFT), 0, 255)
+    void (*vertical)(const short* const* rows, const short* weight, int taps, unsigned char* dstRow, int lanes);
+};
+
+inline void horizontalLanesQ14(const short* srcRow, short* tmpRow, const int* laneIndex, const short* laneWeight, int lanes, int taps, int begin) {
+    for (int j = begin; j < lanes; ++j) {
+        int result = 0;
+        for (int k = 0; k < taps; ++k) {
+            result += srcRow[laneIndex[k * lanes + j]] * laneWeight[k * lanes + j];
+        }
+        // saturate like _mm_packs_epi32, so tail lanes match the vector body
+        int value = (result + (1 << (FIXED_HORIZONTAL_SHIFT - 1))) >> FIXED_HORIZONTAL_SHIFT;
+        tmpRow[j] = (short)(value < -32768 ? -32768 : (value > 32767 ? 32767 : value));
+    }
+}
+
+inline void verticalLanesQ14(const short* const* rows, const short* weight, int taps, unsigned char* dstRow, int lanes, int begin) {
+    for (int j = begin; j < lanes; ++j) {
+        int result = 0;
+        for (int m = 0; m < taps; ++m) {
+            result += rows[m][j] * weight[m];
+        }
+        int value = (result + (1 << (FIXED_VERTICAL_SHIFT - 1))) >> FIXED_VERTICAL_SHIFT;
+        dstRow[j] = (unsigned char)(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+}
+
+void horizontalQ14_Scalar(const short* srcRow, short* tmpRow, const int* laneIndex, const short* laneWeight, int lanes, int taps);
+void verticalQ14_Scalar(const short* const* rows, const short* weight, int taps, unsigned char* dstRow, int lanes);
+void horizontalQ14_AVX2(const short* srcRow, short* tmpRow, const int* laneIndex, const short* laneWeight, int lanes, int taps);
+void verticalQ14_AVX2(const short* const* rows, const short* weight, int taps, unsigned char* dstRow, int lanes);
+
+// 2x2 box reduction of two source rows into one half-width row:
+// dstRow[x * channels + c] = (four source samples + 2) / 4
+inline void boxReducePixels(const unsigned char* row0, const unsigned char* row1, unsigned char* dstRow, int dstWidth, int channels, int begin) {
+    for (int x = begin; x < dstWidth; ++x) {
+        const unsigned char* a = &row0[2 * x * channels];
+        const unsigned char* b = &row1[2 * x * channels];
+        for (int c = 0; c < channels; ++c) {
+            dstRow[x * channels + c] = (unsigned char)((a[c] + a[channels + c] + b[c] + b[channels + c] + 2) >> 2);
+        }
+    }
+}
+
+typedef void (*BoxReduceRowFunc)(const unsigned char* row0, const unsigned char* row1, unsigned char* dstRow, int dstWidth, int channels);
+
+void boxReduceRow_Scalar(const unsigned char* row0, const unsigned char* row1, unsigned char* dstRow, int dstWidth, int channels);
+void boxReduceRow_AVX2(const unsigned char* row0, const unsigned char* row1, unsigned char* dstRow, int dstWidth, int channels);
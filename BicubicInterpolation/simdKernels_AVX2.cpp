@@ -0,0 +1,127 @@
+#include <immintrin.h>
+#include "simdKernels.h"
+
+SIMD_TARGET("avx2,fma")
+void horizontal_AVX2(const float* srcRow, float* tmpRow, const int* laneIndex, const float* laneWeight, int lanes, int taps) {
+    int j = 0;
+    for (; j + 8 <= lanes; j += 8) {
+        __m256 acc = _mm256_setzero_ps();
+        for (int k = 0; k < taps; ++k) {
+            __m256i idx = _mm256_loadu_si256((const __m256i*)&laneIndex[k * lanes + j]);
+            __m256 pixel = _mm256_i32gather_ps(srcRow, idx, 4);
+            acc = _mm256_fmadd_ps(pixel, _mm256_loadu_ps(&laneWeight[k * lanes + j]), acc);
+        }
+        _mm256_storeu_ps(&tmpRow[j], acc);
+    }
+    horizontalLanes(srcRow, tmpRow, laneIndex, laneWeight, lanes, taps, j);
+}
+
+SIMD_TARGET("avx2,fma")
+void vertical_AVX2(const float* const* rows, const float* weight, int taps, unsigned char* dstRow, int lanes) {
+    int j = 0;
+    for (; j + 8 <= lanes; j += 8) {
+        __m256 acc = _mm256_setzero_ps();
+        for (int m = 0; m < taps; ++m) {
+            acc = _mm256_fmadd_ps(_mm256_loadu_ps(&rows[m][j]), _mm256_set1_ps(weight[m]), acc);
+        }
+
+        // truncate like (int)result, then saturate to 0..255
+        __m256i value = _mm256_cvttps_epi32(acc);
+        __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+        _mm_storel_epi64((__m128i*)&dstRow[j], _mm_packus_epi16(words, words));
+    }
+    verticalLanes(rows, weight, taps, dstRow, lanes, j);
+}
+
+// Taps are processed in pairs so _mm256_madd_epi16 does two multiply-adds per
+// 32-bit lane. Source values are fetched with 32-bit gathers at 16-bit scale
+// and only the low half is kept.
+SIMD_TARGET("avx2,fma")
+void horizontalQ14_AVX2(const short* srcRow, short* tmpRow, const int* laneIndex, const short* laneWeight, int lanes, int taps) {
+    const __m256i lowHalf = _mm256_set1_epi32(0xffff);
+    const __m256i round = _mm256_set1_epi32(1 << (FIXED_HORIZONTAL_SHIFT - 1));
+    const int* base = (const int*)srcRow;
+
+    int j = 0;
+    for (; j + 8 <= lanes; j += 8) {
+        __m256i acc = _mm256_setzero_si256();
+        for (int k = 0; k < taps; k += 2) {
+            int k1 = k + 1 < taps ? k + 1 : k;
+            __m256i idx0 = _mm256_loadu_si256((const __m256i*)&laneIndex[k * lanes + j]);
+            __m256i idx1 = _mm256_loadu_si256((const __m256i*)&laneIndex[k1 * lanes + j]);
+            __m256i pixel0 = _mm256_and_si256(_mm256_i32gather_epi32(base, idx0, 2), lowHalf);
+            __m256i pixel1 = _mm256_slli_epi32(_mm256_i32gather_epi32(base, idx1, 2), 16);
+            __m256i pixels = _mm256_or_si256(pixel0, pixel1);
+
+            __m128i weight0 = _mm_loadu_si128((const __m128i*)&laneWeight[k * lanes + j]);
+            __m128i weight1 = k1 != k ? _mm_loadu_si128((const __m128i*)&laneWeight[k1 * lanes + j]) : _mm_setzero_si128();
+            __m256i weights = _mm256_set_m128i(_mm_unpackhi_epi16(weight0, weight1), _mm_unpacklo_epi16(weight0, weight1));
+
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(pixels, weights));
+        }
+
+        acc = _mm256_srai_epi32(_mm256_add_epi32(acc, round), FIXED_HORIZONTAL_SHIFT);
+        __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+        _mm_storeu_si128((__m128i*)&tmpRow[j], words);
+    }
+    horizontalLanesQ14(srcRow, tmpRow, laneIndex, laneWeight, lanes, taps, j);
+}
+
+// 16 int16 lanes per iteration; rows are interleaved in pairs for madd.
+// unpack/pack both work within 128-bit halves, so lane order is preserved
+// until the final cross-half permute.
+SIMD_TARGET("avx2,fma")
+void verticalQ14_AVX2(const short* const* rows, const short* weight, int taps, unsigned char* dstRow, int lanes) {
+    const __m256i round = _mm256_set1_epi32(1 << (FIXED_VERTICAL_SHIFT - 1));
+
+    int j = 0;
+    for (; j + 16 <= lanes; j += 16) {
+        __m256i accLo = _mm256_setzero_si256();
+        __m256i accHi = _mm256_setzero_si256();
+        for (int m = 0; m < taps; m += 2) {
+            int m1 = m + 1 < taps ? m + 1 : m;
+            short weight1 = m1 != m ? weight[m1] : 0;
+            __m256i weights = _mm256_set1_epi32((weight[m] & 0xffff) | ((int)weight1 << 16));
+
+            __m256i row0 = _mm256_loadu_si256((const __m256i*)&rows[m][j]);
+            __m256i row1 = _mm256_loadu_si256((const __m256i*)&rows[m1][j]);
+            accLo = _mm256_add_epi32(accLo, _mm256_madd_epi16(_mm256_unpacklo_epi16(row0, row1), weights));
+            accHi = _mm256_add_epi32(accHi, _mm256_madd_epi16(_mm256_unpackhi_epi16(row0, row1), weights));
+        }
+
+        accLo = _mm256_srai_epi32(_mm256_add_epi32(accLo, round), FIXED_VERTICAL_SHIFT);
+        accHi = _mm256_srai_epi32(_mm256_add_epi32(accHi, round), FIXED_VERTICAL_SHIFT);
+        __m256i words = _mm256_packs_epi32(accLo, accHi);
+        __m256i bytes = _mm256_packus_epi16(words, words);
+        bytes = _mm256_permute4x64_epi64(bytes, 0x08);
+        _mm_storeu_si128((__m128i*)&dstRow[j], _mm256_castsi256_si128(bytes));
+    }
+    verticalLanesQ14(rows, weight, taps, dstRow, lanes, j);
+}
+
+// RGBA: 8 source pixels per row -> 4 output pixels per iteration. Rows are
+// widened to u16 and summed, then adjacent 64-bit pixels are added within
+// each 128-bit half and the halves reordered. Other channel counts are scalar.
+SIMD_TARGET("avx2,fma")
+void boxReduceRow_AVX2(const unsigned char* row0, const unsigned char* row1, unsigned char* dstRow, int dstWidth, int channels) {
+    int x = 0;
+    if (channels == 4) {
+        const __m256i round = _mm256_set1_epi16(2);
+        for (; x + 4 <= dstWidth; x += 4) {
+            __m256i a = _mm256_loadu_si256((const __m256i*)&row0[x * 8]);
+            __m256i b = _mm256_loadu_si256((const __m256i*)&row1[x * 8]);
+
+            __m256i sumLo = _mm256_add_epi16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(a)), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(b)));
+            __m256i sumHi = _mm256_add_epi16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(a, 1)), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(b, 1)));
+            sumLo = _mm256_add_epi16(sumLo, _mm256_srli_si256(sumLo, 8));
+            sumHi = _mm256_add_epi16(sumHi, _mm256_srli_si256(sumHi, 8));
+
+            __m256i sum = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(sumLo, sumHi), 0xd8);
+            sum = _mm256_srli_epi16(_mm256_add_epi16(sum, round), 2);
+
+            __m256i bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), 0x08);
+            _mm_storeu_si128((__m128i*)&dstRow[x * 4], _mm256_castsi256_si128(bytes));
+        }
+    }
+    boxReducePixels(row0, row1, dstRow, dstWidth, channels, x);
+}
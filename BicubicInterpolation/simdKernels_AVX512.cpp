@@ -0,0 +1,33 @@
+#include <immintrin.h>
+#include "simdKernels.h"
+
+SIMD_TARGET("avx512f,avx512bw")
+void horizontal_AVX512(const float* srcRow, float* tmpRow, const int* laneIndex, const float* laneWeight, int lanes, int taps) {
+    int j = 0;
+    for (; j + 16 <= lanes; j += 16) {
+        __m512 acc = _mm512_setzero_ps();
+        for (int k = 0; k < taps; ++k) {
+            __m512i idx = _mm512_loadu_si512((const void*)&laneIndex[k * lanes + j]);
+            __m512 pixel = _mm512_i32gather_ps(idx, srcRow, 4);
+            acc = _mm512_fmadd_ps(pixel, _mm512_loadu_ps(&laneWeight[k * lanes + j]), acc);
+        }
+        _mm512_storeu_ps(&tmpRow[j], acc);
+    }
+    horizontalLanes(srcRow, tmpRow, laneIndex, laneWeight, lanes, taps, j);
+}
+
+SIMD_TARGET("avx512f,avx512bw")
+void vertical_AVX512(const float* const* rows, const float* weight, int taps, unsigned char* dstRow, int lanes) {
+    int j = 0;
+    for (; j + 16 <= lanes; j += 16) {
+        __m512 acc = _mm512_setzero_ps();
+        for (int m = 0; m < taps; ++m) {
+            acc = _mm512_fmadd_ps(_mm512_loadu_ps(&rows[m][j]), _mm512_set1_ps(weight[m]), acc);
+        }
+
+        // truncate like (int)result, clamp negatives, then saturate to 255 on narrowing
+        __m512i value = _mm512_max_epi32(_mm512_cvttps_epi32(acc), _mm512_setzero_si512());
+        _mm_storeu_si128((__m128i*)&dstRow[j], _mm512_cvtusepi32_epi8(value));
+    }
+    verticalLanes(rows, weight, taps, dstRow, lanes, j);
+}
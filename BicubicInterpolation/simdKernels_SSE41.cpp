@@ -0,0 +1,37 @@
+#include <cstring>
+#include <immintrin.h>
+#include "simdKernels.h"
+
+// SSE4.1 has no gather, taps are loaded lane by lane into a vector
+SIMD_TARGET("sse4.1")
+void horizontal_SSE41(const float* srcRow, float* tmpRow, const int* laneIndex, const float* laneWeight, int lanes, int taps) {
+    int j = 0;
+    for (; j + 4 <= lanes; j += 4) {
+        __m128 acc = _mm_setzero_ps();
+        for (int k = 0; k < taps; ++k) {
+            const int* idx = &laneIndex[k * lanes + j];
+            __m128 pixel = _mm_set_ps(srcRow[idx[3]], srcRow[idx[2]], srcRow[idx[1]], srcRow[idx[0]]);
+            acc = _mm_add_ps(acc, _mm_mul_ps(pixel, _mm_loadu_ps(&laneWeight[k * lanes + j])));
+        }
+        _mm_storeu_ps(&tmpRow[j], acc);
+    }
+    horizontalLanes(srcRow, tmpRow, laneIndex, laneWeight, lanes, taps, j);
+}
+
+SIMD_TARGET("sse4.1")
+void vertical_SSE41(const float* const* rows, const float* weight, int taps, unsigned char* dstRow, int lanes) {
+    int j = 0;
+    for (; j + 4 <= lanes; j += 4) {
+        __m128 acc = _mm_setzero_ps();
+        for (int m = 0; m < taps; ++m) {
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(&rows[m][j]), _mm_set1_ps(weight[m])));
+        }
+
+        // truncate like (int)result, then saturate to 0..255
+        __m128i value = _mm_cvttps_epi32(acc);
+        value = _mm_packus_epi16(_mm_packs_epi32(value, value), value);
+        int packed = _mm_cvtsi128_si32(value);
+        memcpy(&dstRow[j], &packed, 4);
+    }
+    verticalLanes(rows, weight, taps, dstRow, lanes, j);
+}
@@ -0,0 +1,147 @@
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <omp.h>
+#include "simd_ResizeBicubic.h"
+#include "simdKernels.h"
+#include "serial_ResizeBicubic.h"
+#include "bufferArena.h"
+#include "resizeCore.h"
+
+using namespace std;
+
+void horizontal_Scalar(const float* srcRow, float* tmpRow, const int* laneIndex, const float* laneWeight, int lanes, int taps) {
+    horizontalLanes(srcRow, tmpRow, laneIndex, laneWeight, lanes, taps, 0);
+}
+
+void vertical_Scalar(const float* const* rows, const float* weight, int taps, unsigned char* dstRow, int lanes) {
+    verticalLanes(rows, weight, taps, dstRow, lanes, 0);
+}
+
+static SimdKernels simdKernelsFor(SimdLevel level) {
+    switch (level) {
+    case SIMD_AVX512: return { horizontal_AVX512, vertical_AVX512 };
+    case SIMD_AVX2: return { horizontal_AVX2, vertical_AVX2 };
+    case SIMD_SSE41: return { horizontal_SSE41, vertical_SSE41 };
+    default: return { horizontal_Scalar, vertical_Scalar };
+    }
+}
+
+SimdLevel simd_ActiveLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+// Same two passes as separable_ResizeBicubic, with the per-lane work done by
+// the kernels of the requested instruction set.
+void simd_ResizeBicubic(const ResizePlan& plan, const ImageView& src, const ImageView& dst, SimdLevel level) {
+    int channels = src.channels;
+    int srcWidth = plan.srcWidth;
+    int srcHeight = plan.srcHeight;
+    int dstWidth = plan.dstWidth;
+    int dstHeight = plan.dstHeight;
+    int xTaps = plan.xTaps;
+    int yTaps = plan.yTaps;
+    int lanes = dstWidth * channels;
+    SimdKernels kernels = simdKernelsFor(level);
+
+    // expand the column tables to one entry per lane so every lane loads contiguously
+    ArenaBuffer<int> laneIndex((size_t)xTaps * lanes);
+    ArenaBuffer<float> laneWeight((size_t)xTaps * lanes);
+    for (int k = 0; k < xTaps; ++k) {
+        for (int x = 0; x < dstWidth; ++x) {
+            for (int c = 0; c < channels; ++c) {
+                laneIndex[(size_t)k * lanes + x * channels + c] = plan.xIndex[x * xTaps + k] * channels + c;
+                laneWeight[(size_t)k * lanes + x * channels + c] = plan.xWeight[x * xTaps + k];
+            }
+        }
+    }
+
+    // BORDER_CONSTANT reads a virtual pixel past the end of each row and a
+    // virtual row past the last one; both are appended so the kernels stay branch-free
+    bool constant = plan.border == BORDER_CONSTANT;
+    ArenaBuffer<float> tmp((size_t)(srcHeight + (constant ? 1 : 0)) * lanes);
+    vector<float> constantRow((size_t)(srcWidth + 1) * channels);
+    for (size_t i = 0; i < constantRow.size(); ++i) {
+        constantRow[i] = borderPixel<unsigned char>(plan, (int)(i % channels));
+    }
+
+    // horizontal pass: source rows -> intermediate
+    #pragma omp parallel
+    {
+        vector<float> srcRowF(constantRow);
+
+        #pragma omp for
+        for (int y = 0; y < srcHeight; ++y) {
+            const unsigned char* srcRow = src.row(y);
+            for (int i = 0; i < srcWidth * channels; ++i) {
+                srcRowF[i] = srcRow[i];
+            }
+            kernels.horizontal(srcRowF.data(), &tmp[(size_t)y * lanes], laneIndex.data(), laneWeight.data(), lanes, xTaps);
+        }
+    }
+
+    if (constant) {
+        kernels.horizontal(constantRow.data(), &tmp[(size_t)srcHeight * lanes], laneIndex.data(), laneWeight.data(), lanes, xTaps);
+    }
+
+    // vertical pass: intermediate -> destination rows
+    #pragma omp parallel
+    {
+        vector<const float*> rows(yTaps);
+
+        #pragma omp for
+        for (int y = 0; y < dstHeight; ++y) {
+            for (int m = 0; m < yTaps; ++m) {
+                rows[m] = &tmp[(size_t)plan.yIndex[y * yTaps + m] * lanes];
+            }
+            kernels.vertical(rows.data(), &plan.yWeight[y * yTaps], yTaps, dst.row(y), lanes);
+        }
+    }
+}
+
+void simd_ResizeBicubic(const ResizePlan& plan, unsigned char* src, int channels, unsigned char* dst, SimdLevel level) {
+    simd_ResizeBicubic(plan, ImageView(src, plan.srcWidth, plan.srcHeight, channels), ImageView(dst, plan.dstWidth, plan.dstHeight, channels),
+        level);
+}
+
+void simd_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels,
+    unsigned char* dst, int dstWidth, int dstHeight) {
+    simd_ResizeBicubic(*getResizePlan(srcWidth, srcHeight, dstWidth, dstHeight), src, channels, dst, simd_ActiveLevel());
+}
+
+void simd_ResizeBicubic(const ImageView& src, const ImageView& dst) {
+    simd_ResizeBicubic(*getResizePlan(src.width, src.height, dst.width, dst.height), src, dst, simd_ActiveLevel());
+}
+
+int simd_CheckAgainstSerial(SimdLevel level) {
+    // odd sizes so every kernel also runs its tail lanes, up- and downscale
+    const int sizes[][4] = { { 157, 93, 411, 250 }, { 157, 93, 61, 37 } };
+    // clamped edges, and a constant colour outside [0, 255] that must saturate alike
+    const BorderMode borders[] = { BORDER_CLAMP, BORDER_CONSTANT };
+    const vector<float> borderColor = { 300.0f, -20.0f, 128.6f, 255.0f };
+    int maxDiff = 0;
+
+    srand(1);
+    for (const auto& size : sizes) {
+        for (BorderMode border : borders) {
+            for (int channels = 1; channels <= 4; ++channels) {
+                vector<unsigned char> src((size_t)size[0] * size[1] * channels);
+                for (size_t i = 0; i < src.size(); ++i) {
+                    src[i] = (unsigned char)(rand() & 255);
+                }
+
+                vector<unsigned char> expected((size_t)size[2] * size[3] * channels);
+                vector<unsigned char> actual(expected.size());
+                const ResizePlan plan(size[0], size[1], size[2], size[3], CatmullRomKernel(), border, borderColor);
+                serial_ResizeBicubic(plan, src.data(), channels, expected.data());
+                simd_ResizeBicubic(plan, src.data(), channels, actual.data(), level);
+
+                for (size_t i = 0; i < expected.size(); ++i) {
+                    maxDiff = max(maxDiff, abs((int)expected[i] - (int)actual[i]));
+                }
+            }
+        }
+    }
+    return maxDiff;
+}
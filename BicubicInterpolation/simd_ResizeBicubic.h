@@ -0,0 +1,22 @@
+#pragma once
+#include "resizePlan.h"
+#include "cpuFeatures.h"
+#include "imageView.h"
+void simd_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+void simd_ResizeBicubic(const ResizePlan& plan, unsigned char* src, int channels, unsigned char* dst, SimdLevel level);
+
+// Strided source and destination; the plan sizes are the view sizes
+void simd_ResizeBicubic(const ResizePlan& plan, const ImageView& src, const ImageView& dst, SimdLevel level);
+void simd_ResizeBicubic(const ImageView& src, const ImageView& dst);
+
+// Level picked at startup from cpuid
+SimdLevel simd_ActiveLevel();
+
+// resizeFunc-compatible entry point for any plan kernel
+template<typename Kernel>
+void simd_Resize(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight) {
+    simd_ResizeBicubic(*getResizePlan<Kernel>(srcWidth, srcHeight, dstWidth, dstHeight), src, channels, dst, simd_ActiveLevel());
+}
+
+// Largest per-sample difference against serial_ResizeBicubic on a synthetic image
+int simd_CheckAgainstSerial(SimdLevel level);
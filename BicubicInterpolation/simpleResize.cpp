@@ -1,7 +1,15 @@
+#include "simpleResize.h"
+
 void simple_Resize(unsigned char* src, int srcWidth, int srcHeight, int channels,
     unsigned char* dst, int dstWidth, int dstHeight) {
-    float scaleX = (float)srcWidth / dstWidth;
-    float scaleY = (float)srcHeight / dstHeight;
+    simple_Resize(ImageView(src, srcWidth, srcHeight, channels), ImageView(dst, dstWidth, dstHeight, channels));
+}
+
+void simple_Resize(const ImageView& src, const ImageView& dst) {
+    int channels = src.channels;
+    int dstWidth = dst.width, dstHeight = dst.height;
+    float scaleX = (float)src.width / dstWidth;
+    float scaleY = (float)src.height / dstHeight;
 
     #pragma omp parallel for
     for (int y = 0; y < dstHeight; ++y) {
@@ -10,7 +18,7 @@ void simple_Resize(unsigned char* src, int srcWidth, int srcHeight, int channels
             int srcY = (int)(y * scaleY);
 
             for (int c = 0; c < channels; ++c) {
-                dst[(y * dstWidth + x) * channels + c] = src[(srcY * srcWidth + srcX) * channels + c];
+                dst.pixel(x, y)[c] = src.pixel(srcX, srcY)[c];
             }
         }
     }
@@ -1,2 +1,4 @@
 #pragma once
-void simple_Resize(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
\ No newline at end of file
+#include "imageView.h"
+void simple_Resize(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+void simple_Resize(const ImageView& src, const ImageView& dst);
\ No newline at end of file
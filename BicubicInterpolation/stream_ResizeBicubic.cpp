@@ -0,0 +1,159 @@
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+#include "resizeCore.h"
+#include "stream_ResizeBicubic.h"
+#include "separable_ResizeBicubic.h"
+
+using namespace std;
+
+int stream_RingRows(const ResizePlan& plan) {
+    // rows stay in the ring from the moment they are pulled until the last
+    // output that reads them; replay the pulls to find the widest window
+    int taps = plan.yTaps;
+    int pulled = -1;
+    int ringRows = 1;
+    for (int y = 0; y < plan.dstHeight; ++y) {
+        int lowest = plan.srcHeight;
+        for (int m = 0; m < taps; ++m) {
+            int row = plan.yIndex[y * taps + m];
+            if (row == plan.srcHeight) {
+                continue;  // BORDER_CONSTANT virtual row, kept outside the ring
+            }
+            pulled = max(pulled, row);
+            lowest = min(lowest, row);
+        }
+        if (lowest < plan.srcHeight) {
+            ringRows = max(ringRows, pulled - lowest + 1);
+        }
+    }
+    return min(ringRows, plan.srcHeight);
+}
+
+template<int Channels>
+static bool streamResize(const ResizePlan& plan, int channels, const RowSource& source, const RowSink& sink) {
+    const int ch = Channels > 0 ? Channels : channels;
+    const int taps = plan.yTaps;
+    const int lanes = plan.dstWidth * ch;
+    const int ringRows = stream_RingRows(plan);
+
+    vector<unsigned char> srcRow((size_t)plan.srcWidth * ch);
+    vector<unsigned char> dstRow(lanes);
+    vector<float> ring((size_t)ringRows * lanes);
+    vector<float> constantRow;
+    vector<const float*> rows(taps);
+
+    if (plan.border == BORDER_CONSTANT) {
+        for (size_t i = 0; i < srcRow.size(); ++i) {
+            srcRow[i] = borderPixel<unsigned char>(plan, (int)(i % ch));
+        }
+        constantRow.resize(lanes);
+        horizontalRow<Channels, unsigned char>(plan, srcRow.data(), ch, constantRow.data());
+    }
+
+    int nextRow = 0;
+    for (int y = 0; y < plan.dstHeight; ++y) {
+        // pull every row this output reads that has not arrived yet
+        for (int m = 0; m < taps; ++m) {
+            int row = plan.yIndex[y * taps + m];
+            while (row < plan.srcHeight && nextRow <= row) {
+                if (!source(nextRow, srcRow.data())) {
+                    return false;
+                }
+                horizontalRow<Channels, unsigned char>(plan, srcRow.data(), ch, &ring[(size_t)(nextRow % ringRows) * lanes]);
+                ++nextRow;
+            }
+        }
+
+        for (int m = 0; m < taps; ++m) {
+            int row = plan.yIndex[y * taps + m];
+            rows[m] = row == plan.srcHeight ? constantRow.data() : &ring[(size_t)(row % ringRows) * lanes];
+        }
+        verticalRow<unsigned char>(rows.data(), &plan.yWeight[y * taps], taps, dstRow.data(), lanes);
+
+        if (!sink(y, dstRow.data())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool stream_ResizeBicubic(const ResizePlan& plan, int channels, const RowSource& source, const RowSink& sink) {
+    switch (channels) {
+    case 1: return streamResize<1>(plan, channels, source, sink);
+    case 2: return streamResize<2>(plan, channels, source, sink);
+    case 3: return streamResize<3>(plan, channels, source, sink);
+    case 4: return streamResize<4>(plan, channels, source, sink);
+    default: return streamResize<0>(plan, channels, source, sink);
+    }
+}
+
+bool stream_ResizeBicubic(int srcWidth, int srcHeight, int channels, int dstWidth, int dstHeight,
+    const RowSource& source, const RowSink& sink) {
+    return stream_ResizeBicubic(*getResizePlan(srcWidth, srcHeight, dstWidth, dstHeight), channels, source, sink);
+}
+
+void stream_ResizeBicubic(const ImageView& src, const ImageView& dst) {
+    size_t srcRowBytes = (size_t)src.width * src.channels;
+    size_t dstRowBytes = (size_t)dst.width * dst.channels;
+
+    stream_ResizeBicubic(src.width, src.height, src.channels, dst.width, dst.height,
+        [&](int y, unsigned char* row) {
+            memcpy(row, src.row(y), srcRowBytes);
+            return true;
+        },
+        [&](int y, const unsigned char* row) {
+            memcpy(dst.row(y), row, dstRowBytes);
+            return true;
+        });
+}
+
+void stream_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels,
+    unsigned char* dst, int dstWidth, int dstHeight) {
+    stream_ResizeBicubic(ImageView(src, srcWidth, srcHeight, channels), ImageView(dst, dstWidth, dstHeight, channels));
+}
+
+int stream_CheckAgainstSeparable() {
+    // odd sizes, up- and downscale; 5 channels takes the generic path
+    const int sizes[][4] = { { 157, 93, 411, 250 }, { 157, 93, 61, 37 } };
+    const int channelCounts[] = { 1, 3, 4, 5 };
+    const BorderMode borders[] = { BORDER_CLAMP, BORDER_REFLECT, BORDER_WRAP, BORDER_CONSTANT };
+    // out-of-range and fractional samples check that every path clamps the colour alike
+    const vector<float> borderColor = { 300.0f, -20.0f, 128.6f, 255.0f, 10.0f };
+    int maxDiff = 0;
+
+    srand(1);
+    for (const auto& size : sizes) {
+        for (BorderMode border : borders) {
+            const ResizePlan plan(size[0], size[1], size[2], size[3], CatmullRomKernel(), border, borderColor);
+            for (int channels : channelCounts) {
+                vector<unsigned char> src((size_t)size[0] * size[1] * channels);
+                for (size_t i = 0; i < src.size(); ++i) {
+                    src[i] = (unsigned char)(rand() & 255);
+                }
+
+                vector<unsigned char> expected((size_t)size[2] * size[3] * channels);
+                vector<unsigned char> actual(expected.size());
+                separable_ResizeBicubic(plan, src.data(), channels, expected.data());
+
+                size_t srcRowBytes = (size_t)size[0] * channels, dstRowBytes = (size_t)size[2] * channels;
+                stream_ResizeBicubic(plan, channels,
+                    [&](int y, unsigned char* row) {
+                        memcpy(row, &src[y * srcRowBytes], srcRowBytes);
+                        return true;
+                    },
+                    [&](int y, const unsigned char* row) {
+                        memcpy(&actual[y * dstRowBytes], row, dstRowBytes);
+                        return true;
+                    });
+
+                for (size_t i = 0; i < expected.size(); ++i) {
+                    maxDiff = max(maxDiff, abs((int)expected[i] - (int)actual[i]));
+                }
+            }
+        }
+    }
+    return maxDiff;
+}
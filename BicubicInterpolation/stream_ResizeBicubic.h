@@ -0,0 +1,32 @@
+#pragma once
+#include <functional>
+#include "resizePlan.h"
+#include "imageView.h"
+
+// Fills row with source row y (srcWidth * channels bytes). Rows are requested
+// in increasing order, each once, so a streaming decoder can feed it directly.
+// Return false to abort the resize.
+typedef std::function<bool(int y, unsigned char* row)> RowSource;
+
+// Receives output row y (dstWidth * channels bytes) in increasing order; the
+// buffer is reused after the call returns. Return false to abort the resize.
+typedef std::function<bool(int y, const unsigned char* row)> RowSink;
+
+// Separable resize that holds a ring of horizontally filtered rows instead of
+// the whole image: peak memory is about (yTaps + 1) x dstWidth floats plus one
+// source and one output row. Output matches separable_ResizeBicubic exactly.
+// BORDER_WRAP needs the last rows for the first outputs, so its ring grows to
+// the full source height. Returns false if the source or sink aborted.
+bool stream_ResizeBicubic(const ResizePlan& plan, int channels, const RowSource& source, const RowSink& sink);
+bool stream_ResizeBicubic(int srcWidth, int srcHeight, int channels, int dstWidth, int dstHeight, const RowSource& source, const RowSink& sink);
+
+// Ring rows stream_ResizeBicubic keeps for the plan
+int stream_RingRows(const ResizePlan& plan);
+
+// resizeFunc-compatible wrapper over in-memory buffers, for the timing driver
+void stream_ResizeBicubic(unsigned char* src, int srcWidth, int srcHeight, int channels, unsigned char* dst, int dstWidth, int dstHeight);
+void stream_ResizeBicubic(const ImageView& src, const ImageView& dst);
+
+// Largest per-sample difference against separable_ResizeBicubic over every
+// border mode and 1, 3, 4 and 5 channels; 0 when the two agree exactly
+int stream_CheckAgainstSeparable();
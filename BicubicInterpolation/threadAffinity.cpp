@@ -0,0 +1,210 @@
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <omp.h>
+#include "threadAffinity.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sched.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <cstring>
+#include <cctype>
+#endif
+
+using namespace std;
+
+#if defined(_WIN32)
+
+vector<LogicalCpu> detectCpuTopology() {
+    vector<LogicalCpu> cpus;
+    DWORD length = 0;
+    GetLogicalProcessorInformation(nullptr, &length);
+    vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    if (!GetLogicalProcessorInformation(info.data(), &length)) {
+        return cpus;
+    }
+
+    int core = 0;
+    for (const SYSTEM_LOGICAL_PROCESSOR_INFORMATION& entry : info) {
+        if (entry.Relationship != RelationProcessorCore) {
+            continue;
+        }
+        for (int bit = 0; bit < (int)(8 * sizeof(ULONG_PTR)); ++bit) {
+            if (entry.ProcessorMask & ((ULONG_PTR)1 << bit)) {
+                UCHAR node = 0;
+                GetNumaProcessorNode((UCHAR)bit, &node);
+                cpus.push_back(LogicalCpu{ bit, core, 0, node == 0xff ? 0 : (int)node });
+            }
+        }
+        ++core;
+    }
+    return cpus;
+}
+
+bool pinCurrentThread(int cpu) {
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) != 0;
+}
+
+void unpinCurrentThread() {
+    DWORD_PTR processMask, systemMask;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+        SetThreadAffinityMask(GetCurrentThread(), processMask);
+    }
+}
+
+#else
+
+static int readTopologyValue(int cpu, const char* name) {
+    ifstream file("/sys/devices/system/cpu/cpu" + to_string(cpu) + "/topology/" + name);
+    int value = -1;
+    file >> value;
+    return value;
+}
+
+// the cpuN directory holds a nodeK link for the node the CPU belongs to
+static int cpuNode(int cpu) {
+    int node = 0;
+    DIR* dir = opendir(("/sys/devices/system/cpu/cpu" + to_string(cpu)).c_str());
+    if (!dir) {
+        return node;
+    }
+    while (dirent* entry = readdir(dir)) {
+        if (strncmp(entry->d_name, "node", 4) == 0 && isdigit((unsigned char)entry->d_name[4])) {
+            node = atoi(entry->d_name + 4);
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+}
+
+// affinity mask the process started with, restored by unpinCurrentThread
+static cpu_set_t processMask() {
+    static const cpu_set_t mask = [] {
+        cpu_set_t initial;
+        CPU_ZERO(&initial);
+        sched_getaffinity(0, sizeof(initial), &initial);
+        return initial;
+    }();
+    return mask;
+}
+
+vector<LogicalCpu> detectCpuTopology() {
+    cpu_set_t mask = processMask();
+    vector<LogicalCpu> cpus;
+
+    // core_id repeats across packages, so number cores by (package, core_id)
+    map<pair<int, int>, int> coreNumbers;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (!CPU_ISSET(cpu, &mask)) {
+            continue;
+        }
+        int package = max(readTopologyValue(cpu, "physical_package_id"), 0);
+        int coreId = readTopologyValue(cpu, "core_id");
+        pair<int, int> key(package, coreId < 0 ? cpu : coreId);
+        if (coreNumbers.find(key) == coreNumbers.end()) {
+            int next = (int)coreNumbers.size();
+            coreNumbers[key] = next;
+        }
+        cpus.push_back(LogicalCpu{ cpu, coreNumbers[key], package, cpuNode(cpu) });
+    }
+    return cpus;
+}
+
+bool pinCurrentThread(int cpu) {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+    return pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask) == 0;
+}
+
+void unpinCurrentThread() {
+    cpu_set_t mask = processMask();
+    pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+}
+
+#endif
+
+int physicalCoreCount(const vector<LogicalCpu>& cpus) {
+    set<int> cores;
+    for (const LogicalCpu& cpu : cpus) {
+        cores.insert(cpu.core);
+    }
+    return (int)cores.size();
+}
+
+int numaNodeCount(const vector<LogicalCpu>& cpus) {
+    set<int> nodes;
+    for (const LogicalCpu& cpu : cpus) {
+        nodes.insert(cpu.node);
+    }
+    return max((int)nodes.size(), 1);
+}
+
+vector<int> affinityOrder(const vector<LogicalCpu>& cpus, AffinityPolicy policy) {
+    vector<LogicalCpu> sorted = cpus;
+    vector<int> order;
+
+    if (policy == AFFINITY_COMPACT) {
+        stable_sort(sorted.begin(), sorted.end(), [](const LogicalCpu& a, const LogicalCpu& b) { return a.core < b.core; });
+        for (const LogicalCpu& cpu : sorted) {
+            order.push_back(cpu.id);
+        }
+        return order;
+    }
+
+    // scatter: rank each CPU among its core's siblings, then take rank 0 of
+    // every core before any rank 1
+    map<int, int> siblingsSeen;
+    vector<pair<int, int>> ranked;
+    for (const LogicalCpu& cpu : sorted) {
+        int rank = siblingsSeen[cpu.core]++;
+        ranked.push_back(make_pair(rank, cpu.id));
+    }
+    stable_sort(ranked.begin(), ranked.end(), [](const pair<int, int>& a, const pair<int, int>& b) { return a.first < b.first; });
+    for (const pair<int, int>& cpu : ranked) {
+        if (policy == AFFINITY_NO_SMT && cpu.first > 0) {
+            break;
+        }
+        order.push_back(cpu.second);
+    }
+    return order;
+}
+
+void pinOpenMPTeam(int threads, AffinityPolicy policy) {
+    if (policy == AFFINITY_NONE) {
+        unpinOpenMPTeam(threads);
+        return;
+    }
+    vector<int> order = affinityOrder(detectCpuTopology(), policy);
+    if (order.empty()) {
+        return;
+    }
+
+    #pragma omp parallel num_threads(threads)
+    {
+        int t = omp_get_thread_num();
+        pinCurrentThread(order[t % order.size()]);
+    }
+}
+
+void unpinOpenMPTeam(int threads) {
+    #pragma omp parallel num_threads(threads)
+    {
+        unpinCurrentThread();
+    }
+}
+
+const char* affinityPolicyName(AffinityPolicy policy) {
+    switch (policy) {
+    case AFFINITY_COMPACT: return "compact";
+    case AFFINITY_SCATTER: return "scatter";
+    case AFFINITY_NO_SMT: return "smt-off";
+    default: return "none";
+    }
+}
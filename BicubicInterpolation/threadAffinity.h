@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+
+// How a team of threads is laid out over the logical CPUs
+enum AffinityPolicy {
+    AFFINITY_NONE,     // left to the OS scheduler
+    AFFINITY_COMPACT,  // fill both SMT siblings of a core before the next core
+    AFFINITY_SCATTER,  // one thread per core first, siblings only after every core is busy
+    AFFINITY_NO_SMT    // one thread per core, never a sibling (at most one thread per core)
+};
+
+struct LogicalCpu {
+    int id;       // OS processor number
+    int core;     // physical core, unique across packages
+    int package;
+    int node;     // NUMA node, 0 on single-node hosts
+};
+
+// Logical CPUs this process may run on, with their core and package
+std::vector<LogicalCpu> detectCpuTopology();
+
+int physicalCoreCount(const std::vector<LogicalCpu>& cpus);
+int numaNodeCount(const std::vector<LogicalCpu>& cpus);
+
+// OS processor numbers in the order the policy hands them to threads 0, 1, ...
+std::vector<int> affinityOrder(const std::vector<LogicalCpu>& cpus, AffinityPolicy policy);
+
+// Pins / unpins the calling thread; false if the OS refused
+bool pinCurrentThread(int cpu);
+void unpinCurrentThread();
+
+// Pins the threads of an OpenMP team of the given size by policy. OpenMP
+// keeps its worker threads between regions, so later regions with the same
+// team size run on the pinned threads.
+void pinOpenMPTeam(int threads, AffinityPolicy policy);
+void unpinOpenMPTeam(int threads);
+
+const char* affinityPolicyName(AffinityPolicy policy);
@@ -0,0 +1,165 @@
+#include <iostream>
+#include "threadPool.h"
+
+using namespace std;
+
+// index of the pool worker running on this thread, -1 for outside threads
+static thread_local int currentWorker = -1;
+
+static unsigned int nextRandom(unsigned int& seed) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+ThreadPool::ThreadPool(int workerCount) : pending(0), stopping(false) {
+    if (workerCount <= 0) {
+        workerCount = (int)thread::hardware_concurrency() - 1;
+    }
+    workerCount = max(workerCount, 0);
+
+    // one queue per worker plus one shared by outside callers
+    for (int i = 0; i <= workerCount; ++i) {
+        queues.push_back(unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (int i = 0; i < workerCount; ++i) {
+        workers.push_back(thread(&ThreadPool::workerLoop, this, i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+bool ThreadPool::popLocal(int worker, Task& task) {
+    WorkerQueue& queue = *queues[worker];
+    lock_guard<mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(int thief, unsigned int& seed, Task& task) {
+    int queueCount = (int)queues.size();
+    int start = (int)(nextRandom(seed) % queueCount);
+
+    // random first victim, then sweep the rest so no queued task is missed
+    for (int i = 0; i < queueCount; ++i) {
+        int victim = (start + i) % queueCount;
+        if (victim == thief) {
+            continue;
+        }
+        WorkerQueue& queue = *queues[victim];
+        lock_guard<mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(const Task& task) {
+    pending.fetch_sub(1);
+    Call& call = *task.call;
+    try {
+        (*call.body)(task.index);
+    }
+    catch (...) {
+        // a throwing task must still count down, or its parallelFor never returns
+        lock_guard<mutex> lock(call.errorMutex);
+        if (!call.error) {
+            call.error = current_exception();
+        }
+    }
+    call.remaining.fetch_sub(1, memory_order_release);
+}
+
+void ThreadPool::workerLoop(int worker) {
+    currentWorker = worker;
+    unsigned int seed = 2654435761u * (worker + 1);
+    const int spinLimit = 2000;
+    int idle = 0;
+
+    while (true) {
+        Task task;
+        if (popLocal(worker, task) || steal(worker, seed, task)) {
+            run(task);
+            idle = 0;
+            continue;
+        }
+
+        // stay hot briefly, small resizes arrive back to back
+        if (++idle < spinLimit) {
+            this_thread::yield();
+            continue;
+        }
+
+        unique_lock<mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || pending.load() > 0; });
+        if (stopping && pending.load() == 0) {
+            return;
+        }
+        idle = 0;
+    }
+}
+
+void ThreadPool::parallelFor(int count, const function<void(int)>& body) {
+    if (count <= 0) {
+        return;
+    }
+
+    int caller = currentWorker >= 0 ? currentWorker : (int)workers.size();
+    Call call;
+    call.body = &body;
+    call.remaining = count;
+
+    // count before queueing so a worker that pops early never sees pending go negative
+    pending.fetch_add(count);
+
+    // deal tasks round-robin so every worker starts with local work
+    int queueCount = (int)queues.size();
+    for (int i = 0; i < count; ++i) {
+        WorkerQueue& queue = *queues[(caller + i) % queueCount];
+        lock_guard<mutex> lock(queue.mutex);
+        queue.tasks.push_back(Task{ &call, i });
+    }
+    {
+        lock_guard<mutex> lock(sleepMutex);
+    }
+    wake.notify_all();
+
+    // help until this call's tasks are done; stolen tasks may belong to other calls
+    unsigned int seed = 2654435761u * (caller + 1);
+    while (call.remaining.load(memory_order_acquire) > 0) {
+        Task task;
+        if (popLocal(caller, task) || steal(caller, seed, task)) {
+            run(task);
+        }
+        else {
+            this_thread::yield();
+        }
+    }
+
+    // only now is no task left that could still touch call
+    if (call.error) {
+        rethrow_exception(call.error);
+    }
+}
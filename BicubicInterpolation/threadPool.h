@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent work-stealing pool. Every worker owns a deque: it pops its own
+// tasks from the back and steals from the front of a random victim when it
+// runs dry. Workers stay alive between calls and sleep only after a short
+// spin, so back-to-back small resizes skip the fork/join of an OpenMP region.
+class ThreadPool {
+public:
+    // workers == 0 uses hardware_concurrency - 1, since the caller also runs tasks
+    explicit ThreadPool(int workers = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Shared pool used by the pool_ backends, created on first use
+    static ThreadPool& instance();
+
+    int workerCount() const { return (int)workers.size(); }
+
+    // Runs body(i) for i in [0, count) and returns when all have finished.
+    // The calling thread works on the tasks too, so nested calls cannot deadlock.
+    // If any body throws, the rest still run and the first exception is
+    // rethrown here once they have.
+    void parallelFor(int count, const std::function<void(int)>& body);
+
+private:
+    // One parallelFor call: tasks still to finish and the first exception thrown
+    struct Call {
+        const std::function<void(int)>* body;
+        std::atomic<int> remaining;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    struct Task {
+        Call* call;
+        int index;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool popLocal(int worker, Task& task);
+    bool steal(int thief, unsigned int& seed, Task& task);
+    void run(const Task& task);
+    void workerLoop(int worker);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::atomic<int> pending;
+    std::atomic<bool> stopping;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+};
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include "tiledImage.h"
+
+using namespace std;
+
+static const char tiledMagic[8] = { 'B', 'C', 'T', 'I', 'L', 'E', '1', '\0' };
+
+// the header gets a page of its own so tile data starts page-aligned
+static const uint32_t tiledHeaderBytes = 4096;
+
+bool TiledImage::open(const string& path, bool writable) {
+    if (!file.open(path, writable) || file.size() < sizeof(TiledImageHeader)) {
+        file.close();
+        return false;
+    }
+    memcpy(&header, file.data(), sizeof(header));
+
+    bool valid = memcmp(header.magic, tiledMagic, sizeof(tiledMagic)) == 0 && header.width > 0 && header.height > 0
+        && header.channels > 0 && header.tileWidth > 0 && header.tileHeight > 0 && header.headerBytes >= sizeof(header);
+    if (!valid || file.size() < tileOffset(0, tilesY())) {
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+bool TiledImage::create(const string& path, int width, int height, int channels, int tileWidth, int tileHeight) {
+    // the same sizes open() insists on; tilesX/tilesY divide by the tile size
+    if (width <= 0 || height <= 0 || channels <= 0 || tileWidth <= 0 || tileHeight <= 0) {
+        return false;
+    }
+    memcpy(header.magic, tiledMagic, sizeof(tiledMagic));
+    header.headerBytes = tiledHeaderBytes;
+    header.width = width;
+    header.height = height;
+    header.channels = channels;
+    header.tileWidth = tileWidth;
+    header.tileHeight = tileHeight;
+
+    if (!file.create(path, tileOffset(0, tilesY()))) {
+        return false;
+    }
+    memcpy(file.data(), &header, sizeof(header));
+    return true;
+}
+
+ImageView TiledImage::tile(int tx, int ty) const {
+    int x0 = tx * tileWidth(), y0 = ty * tileHeight();
+    return ImageView(file.data() + tileOffset(tx, ty), min(tileWidth(), width() - x0), min(tileHeight(), height() - y0),
+        channels(), (size_t)tileWidth() * channels());
+}
+
+template<typename Body>
+void TiledImage::forEachTile(int x, int y, int w, int h, Body body) const {
+    int x1 = min(x + w, width()), y1 = min(y + h, height());
+    x = max(x, 0);
+    y = max(y, 0);
+    if (x >= x1 || y >= y1) {
+        return;
+    }
+    for (int ty = y / tileHeight(); ty <= (y1 - 1) / tileHeight(); ++ty) {
+        for (int tx = x / tileWidth(); tx <= (x1 - 1) / tileWidth(); ++tx) {
+            body(tile(tx, ty), tx * tileWidth(), ty * tileHeight());
+        }
+    }
+}
+
+void TiledImage::readRegion(int x, int y, const ImageView& dst) const {
+    forEachTile(x, y, dst.width, dst.height, [&](const ImageView& tile, int tileX, int tileY) {
+        // the part of this tile that dst covers, in image coordinates
+        int x0 = max(x, tileX), x1 = min(x + dst.width, tileX + tile.width);
+        int y0 = max(y, tileY), y1 = min(y + dst.height, tileY + tile.height);
+        for (int row = y0; row < y1; ++row) {
+            memcpy(dst.pixel(x0 - x, row - y), tile.pixel(x0 - tileX, row - tileY), (size_t)(x1 - x0) * tile.channels);
+        }
+    });
+}
+
+void TiledImage::writeRegion(int x, int y, const ImageView& src) const {
+    forEachTile(x, y, src.width, src.height, [&](const ImageView& tile, int tileX, int tileY) {
+        int x0 = max(x, tileX), x1 = min(x + src.width, tileX + tile.width);
+        int y0 = max(y, tileY), y1 = min(y + src.height, tileY + tile.height);
+        for (int row = y0; row < y1; ++row) {
+            memcpy(tile.pixel(x0 - tileX, row - tileY), src.pixel(x0 - x, row - y), (size_t)(x1 - x0) * tile.channels);
+        }
+    });
+}
+
+void TiledImage::prefetchTiles(int tx0, int ty0, int tx1, int ty1) const {
+    // a run of tiles in one tile row is one contiguous range of the file
+    for (int ty = ty0; ty < ty1 && tx0 < tx1; ++ty) {
+        file.prefetch(tileOffset(tx0, ty), (size_t)(tx1 - tx0) * tileBytes());
+    }
+}
+
+void TiledImage::releaseTiles(int tx0, int ty0, int tx1, int ty1) const {
+    for (int ty = ty0; ty < ty1 && tx0 < tx1; ++ty) {
+        file.release(tileOffset(tx0, ty), (size_t)(tx1 - tx0) * tileBytes());
+    }
+}
+
+bool tiled_WriteImage(const string& path, const ImageView& image, int tileWidth, int tileHeight) {
+    TiledImage tiled;
+    if (!tiled.create(path, image.width, image.height, image.channels, tileWidth, tileHeight)) {
+        return false;
+    }
+    tiled.writeRegion(0, 0, image);
+    return tiled.flush();
+}
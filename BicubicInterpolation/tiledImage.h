@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "imageView.h"
+#include "mappedFile.h"
+
+// Raw tiled image file: a one-page header, then tilesX x tilesY tiles in
+// row-major order, each tileWidth x tileHeight interleaved 8-bit pixels
+// (edge tiles padded to full size, so every tile is at a fixed offset).
+// Tiles of 64 x 64 pixels or more are whole pages, so each can be read in
+// and dropped from memory on its own.
+struct TiledImageHeader {
+    char magic[8];  // "BCTILE1\0"
+    uint32_t headerBytes;
+    uint32_t width, height, channels;
+    uint32_t tileWidth, tileHeight;
+};
+
+class TiledImage {
+public:
+    // Maps an existing tiled file; false if it is missing or not a tiled file
+    bool open(const std::string& path, bool writable = false);
+
+    // Creates a tiled file for width x height x channels, every pixel 0; false
+    // if any size is not positive
+    bool create(const std::string& path, int width, int height, int channels, int tileWidth = 256, int tileHeight = 256);
+
+    void close() { file.close(); }
+    bool flush() const { return file.flush(); }
+
+    int width() const { return (int)header.width; }
+    int height() const { return (int)header.height; }
+    int channels() const { return (int)header.channels; }
+    int tileWidth() const { return (int)header.tileWidth; }
+    int tileHeight() const { return (int)header.tileHeight; }
+    int tilesX() const { return (width() + tileWidth() - 1) / tileWidth(); }
+    int tilesY() const { return (height() + tileHeight() - 1) / tileHeight(); }
+    size_t tileBytes() const { return (size_t)header.tileWidth * header.tileHeight * header.channels; }
+    size_t fileBytes() const { return file.size(); }
+
+    // Pixels of tile (tx, ty), clipped to the image; the pitch is one tile row
+    ImageView tile(int tx, int ty) const;
+
+    // Copies the image pixels under dst placed at (x, y) into dst, or back
+    void readRegion(int x, int y, const ImageView& dst) const;
+    void writeRegion(int x, int y, const ImageView& src) const;
+
+    // Tiles [tx0, tx1) x [ty0, ty1): faulted in ahead of use, or dropped from
+    // memory (written back first when writable)
+    void prefetchTiles(int tx0, int ty0, int tx1, int ty1) const;
+    void releaseTiles(int tx0, int ty0, int tx1, int ty1) const;
+
+private:
+    size_t tileOffset(int tx, int ty) const { return header.headerBytes + ((size_t)ty * tilesX() + tx) * tileBytes(); }
+
+    // Runs body(tile, tileX0, tileY0) for every tile overlapping [x, x + w) x [y, y + h)
+    template<typename Body>
+    void forEachTile(int x, int y, int w, int h, Body body) const;
+
+    MappedFile file;
+    TiledImageHeader header = {};
+};
+
+// Writes an in-memory image as a tiled file
+bool tiled_WriteImage(const std::string& path, const ImageView& image, int tileWidth = 256, int tileHeight = 256);